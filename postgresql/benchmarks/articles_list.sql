@@ -0,0 +1,162 @@
+-- EXPLAIN ANALYZE of the article list functions on 1M articles.
+--
+-- Run against a scratch database, the schema is dropped and recreated:
+--   psql -d realworld_bench -f postgresql/schemas/db_1.sql \
+--        -f postgresql/benchmarks/articles_list.sql
+-- The function signatures are stable, so running the same script on an
+-- older checkout of the schema gives the numbers to compare against.
+
+\timing on
+
+-- 100k users, 1M articles, 1000 tags with 3 tags per article, 5M favorites
+-- skewed towards new articles, 50 followed authors per user
+INSERT INTO realworld.users(username, email, password_hash, bio, image)
+SELECT
+	'user' || i,
+	'user' || i || '@example.com',
+	'hash',
+	CASE WHEN i % 2 = 0 THEN 'bio of user ' || i END,
+	CASE WHEN i % 3 = 0 THEN 'https://example.com/' || i || '.jpg' END
+FROM
+	generate_series(1, 100000) AS i;
+
+INSERT INTO realworld.articles(title, slug, description, body, author_id,
+	created_at, updated_at)
+SELECT
+	'Article ' || i,
+	'article-' || i,
+	'Description of article ' || i,
+	repeat('Body of article ' || i || '. ', 20),
+	1 + (i::BIGINT * 7919) % 100000,
+	NOW() - make_interval(secs => 1000000 - i),
+	NOW() - make_interval(secs => 1000000 - i)
+FROM
+	generate_series(1, 1000000) AS i;
+
+INSERT INTO realworld.tags(name)
+SELECT 'tag' || i FROM generate_series(1, 1000) AS i;
+
+INSERT INTO realworld.article_tags(article_id, tag_id)
+SELECT DISTINCT
+	a.article_id,
+	1 + (a.article_id * k * 31) % 1000
+FROM
+	realworld.articles AS a
+CROSS JOIN
+	generate_series(1, 3) AS k;
+
+-- What add_new_article would have written
+UPDATE realworld.articles AS a
+SET tag_list = ARRAY(
+	SELECT
+		t.name
+	FROM
+		realworld.article_tags AS at
+	INNER JOIN
+		realworld.tags AS t ON t.tag_id = at.tag_id
+	WHERE
+		at.article_id = a.article_id
+	ORDER BY
+		t.name);
+
+-- Bulk inserted tags bypass count_tag_articles, count them here
+UPDATE realworld.tags AS t
+SET articles_count = (
+	SELECT
+		COUNT(*)
+	FROM
+		realworld.article_tags AS at
+	WHERE
+		at.tag_id = t.tag_id);
+
+INSERT INTO realworld.favorites(user_id, article_id)
+SELECT DISTINCT
+	1 + (i::BIGINT * 104729) % 100000,
+	1000000 - floor(1000000 * power(random(), 4))::INT
+FROM
+	generate_series(1, 5000000) AS i
+ON CONFLICT DO NOTHING;
+
+-- Bulk inserted favorites bypass favorite_article, count them here
+INSERT INTO realworld.favorites_counters(article_id, shard, favorites_count)
+SELECT
+	article_id,
+	user_id % 16,
+	COUNT(*)
+FROM
+	realworld.favorites
+GROUP BY
+	article_id, user_id % 16;
+
+INSERT INTO realworld.followers(follower, followed)
+SELECT DISTINCT
+	u.user_id,
+	1 + (u.user_id * k * 7) % 100000
+FROM
+	realworld.users AS u
+CROSS JOIN
+	generate_series(1, 50) AS k
+WHERE
+	u.user_id <> 1 + (u.user_id * k * 7) % 100000
+ON CONFLICT DO NOTHING;
+
+VACUUM ANALYZE;
+
+-- The functions are plpgsql, auto_explain shows the plans of the queries
+-- they run
+LOAD 'auto_explain';
+SET auto_explain.log_min_duration = 0;
+SET auto_explain.log_analyze = on;
+SET auto_explain.log_buffers = on;
+SET auto_explain.log_nested_statements = on;
+SET client_min_messages = log;
+
+-- Anonymous and signed in first page
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile();
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(_user_id => 42);
+
+-- Filters
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(
+	_tag => 'tag7', _user_id => 42);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(
+	_author_username => 'user7919', _user_id => 42);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(
+	_favorited_by_user => 'user42', _user_id => 42);
+
+-- Deep page
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(
+	_user_id => 42, _offset => 10000);
+
+-- The same page by cursor, must not read the 10000 rows before it
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(
+	_user_id => 42,
+	_cursor_created_at => (SELECT created_at FROM realworld.articles
+		ORDER BY created_at DESC, article_id DESC OFFSET 9999 LIMIT 1),
+	_cursor_article_id => (SELECT article_id FROM realworld.articles
+		ORDER BY created_at DESC, article_id DESC OFFSET 9999 LIMIT 1));
+
+-- The feed reads timelines, which the bulk inserts above do not fill, see
+-- feed.sql
+
+-- The viewer columns, every favorited article of the page and every
+-- followed author must be reported as such
+SELECT
+	COUNT(*) FILTER (WHERE a.favorited <> EXISTS (
+		SELECT 1 FROM realworld.favorites AS f
+		WHERE f.user_id = 42 AND f.article_id = a.article_id)) AS wrong_favorited,
+	COUNT(*) FILTER (WHERE a.favorites_count <> (
+		SELECT COUNT(*) FROM realworld.favorites AS f
+		WHERE f.article_id = a.article_id)) AS wrong_favorites_count
+FROM
+	realworld.get_articles_with_author_profile(_user_id => 42, _limit => 500) AS a;
+
+-- Every counter shard must match the favorites it counts
+SELECT COUNT(*) AS wrong_counter_shards
+FROM realworld.get_favorites_counter_mismatches();
@@ -0,0 +1,189 @@
+-- Feed latency and write amplification of the timeline against the former
+-- join of articles with followers, on a power-law follow graph.
+--
+-- Run against a scratch database, the schema is dropped and recreated:
+--   psql -d realworld_bench -f postgresql/schemas/db_1.sql \
+--        -f postgresql/benchmarks/feed.sql
+
+\timing on
+
+-- With 10k users no author would reach the production limit
+CREATE OR REPLACE FUNCTION realworld.timeline_max_fanout()
+    RETURNS INT
+AS $$
+	SELECT 1000;
+$$ LANGUAGE sql IMMUTABLE;
+
+-- 10k users, 100k articles, every user follows 1 to 300 authors picked with
+-- a power law: a few authors are followed by most users, most authors by a
+-- handful
+INSERT INTO realworld.users(username, email, password_hash)
+SELECT
+	'user' || i,
+	'user' || i || '@example.com',
+	'hash'
+FROM
+	generate_series(1, 10000) AS i;
+
+INSERT INTO realworld.articles(title, slug, description, body, author_id,
+	created_at, updated_at)
+SELECT
+	'Article ' || i,
+	'article-' || i,
+	'Description of article ' || i,
+	'Body of article ' || i,
+	1 + (i::BIGINT * 7919) % 10000,
+	NOW() - make_interval(secs => 100000 - i),
+	NOW() - make_interval(secs => 100000 - i)
+FROM
+	generate_series(1, 100000) AS i;
+
+INSERT INTO realworld.followers(follower, followed)
+SELECT DISTINCT
+	u.user_id,
+	1 + floor(10000 * power(random(), 3))::INT
+FROM (
+	SELECT
+		user_id,
+		1 + floor(300 * power(random(), 2))::INT AS follows
+	FROM
+		realworld.users
+) AS u
+CROSS JOIN LATERAL
+	generate_series(1, u.follows) AS k
+ON CONFLICT DO NOTHING;
+
+DELETE FROM realworld.followers WHERE follower = followed;
+
+-- What follow() and add_new_article() would have written for this graph
+INSERT INTO realworld.timeline_pull_authors(author_id)
+SELECT
+	followed
+FROM
+	realworld.followers
+GROUP BY
+	followed
+HAVING
+	COUNT(*) > realworld.timeline_max_fanout();
+
+INSERT INTO realworld.timelines(user_id, created_at, article_id, author_id)
+SELECT
+	f.follower,
+	a.created_at,
+	a.article_id,
+	a.author_id
+FROM
+	realworld.followers AS f
+INNER JOIN
+	realworld.articles AS a ON a.author_id = f.followed
+WHERE
+	NOT EXISTS (
+		SELECT 1 FROM realworld.timeline_pull_authors AS p
+		WHERE p.author_id = f.followed);
+
+VACUUM ANALYZE;
+
+-- The user following the most authors and a median one
+SELECT
+	follower AS heavy_user
+FROM
+	realworld.followers
+GROUP BY
+	follower
+ORDER BY
+	COUNT(*) DESC
+LIMIT 1 \gset
+
+SELECT
+	follower AS median_user
+FROM
+	realworld.followers
+GROUP BY
+	follower
+ORDER BY
+	COUNT(*) DESC
+OFFSET 5000
+LIMIT 1 \gset
+
+-- Write amplification: timeline rows per article, and how many authors and
+-- follow edges are left to the read time merge
+SELECT
+	(SELECT COUNT(*) FROM realworld.timelines)::NUMERIC /
+		(SELECT COUNT(*) FROM realworld.articles) AS timeline_rows_per_article,
+	(SELECT MAX(followers) FROM (
+		SELECT COUNT(*) AS followers
+		FROM realworld.followers
+		WHERE followed NOT IN (SELECT author_id FROM realworld.timeline_pull_authors)
+		GROUP BY followed) AS f) AS max_fanout,
+	(SELECT COUNT(*) FROM realworld.timeline_pull_authors) AS pull_authors,
+	(SELECT COUNT(*) FROM realworld.followers
+		WHERE followed IN (SELECT author_id FROM realworld.timeline_pull_authors))::NUMERIC /
+		(SELECT COUNT(*) FROM realworld.followers) AS pulled_follows_share;
+
+-- Writing an article of the most followed push author and of a pull author
+BEGIN;
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT realworld.add_new_article('Pushed', 'pushed', 'd', 'b',
+	(SELECT followed FROM realworld.followers
+	 WHERE followed NOT IN (SELECT author_id FROM realworld.timeline_pull_authors)
+	 GROUP BY followed ORDER BY COUNT(*) DESC LIMIT 1), NULL);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT realworld.add_new_article('Pulled', 'pulled', 'd', 'b',
+	(SELECT author_id FROM realworld.timeline_pull_authors LIMIT 1), NULL);
+ROLLBACK;
+
+LOAD 'auto_explain';
+SET auto_explain.log_min_duration = 0;
+SET auto_explain.log_analyze = on;
+SET auto_explain.log_buffers = on;
+SET auto_explain.log_nested_statements = on;
+SET client_min_messages = log;
+
+-- The page query get_feed ran before the timeline
+PREPARE join_feed(INT, INT) AS
+SELECT
+	a.article_id
+FROM
+	realworld.articles AS a
+INNER JOIN
+	realworld.followers AS f ON f.followed = a.author_id
+WHERE
+	f.follower = $1
+ORDER BY
+	a.created_at DESC,
+	a.article_id DESC
+LIMIT
+	20
+OFFSET
+	$2;
+
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_feed(:heavy_user, 0);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_feed(:heavy_user);
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_feed(:median_user, 0);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_feed(:median_user);
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_feed(:heavy_user, 1000);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_feed(:heavy_user, 20, 1000);
+
+-- The timeline must give the same feed as the join
+SELECT
+	COUNT(*) AS wrong_feed_rows
+FROM (
+	SELECT article_id FROM realworld.get_feed(:heavy_user, 100)
+	EXCEPT ALL
+	(SELECT
+		a.article_id
+	FROM
+		realworld.articles AS a
+	INNER JOIN
+		realworld.followers AS f ON f.followed = a.author_id
+	WHERE
+		f.follower = :heavy_user
+	ORDER BY
+		a.created_at DESC,
+		a.article_id DESC
+	LIMIT
+		100)
+) AS diff;
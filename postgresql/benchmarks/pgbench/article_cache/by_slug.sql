@@ -0,0 +1,3 @@
+\set article random_zipfian(1, 200000, 1.01)
+\set viewer random(1, 50000)
+SELECT realworld.get_article_with_author_profile_by_slug('article-' || :article::TEXT, :viewer);
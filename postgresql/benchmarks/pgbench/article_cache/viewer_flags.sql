@@ -0,0 +1,3 @@
+\set article random_zipfian(1, 200000, 1.01)
+\set viewer random(1, 50000)
+SELECT * FROM realworld.get_article_viewer_flags(:article, :viewer);
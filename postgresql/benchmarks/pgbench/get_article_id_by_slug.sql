@@ -0,0 +1,2 @@
+\set article random(1, 200000)
+SELECT * FROM realworld.get_article_id_by_slug('article-' || :article::TEXT);
@@ -0,0 +1,2 @@
+\set article random(1, 200000)
+SELECT realworld.get_article_tag_list(:article);
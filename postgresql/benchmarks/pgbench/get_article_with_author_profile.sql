@@ -0,0 +1,3 @@
+\set article random(1, 200000)
+\set viewer random(1, 50000)
+SELECT realworld.get_article_with_author_profile(:article, :viewer);
@@ -0,0 +1,2 @@
+\set viewer random(1, 50000)
+SELECT * FROM realworld.get_articles_with_author_profile(NULL, NULL, NULL, :viewer, 20, 0);
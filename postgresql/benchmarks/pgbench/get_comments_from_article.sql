@@ -0,0 +1,2 @@
+\set article random(1, 200000)
+SELECT * FROM realworld.get_comments_from_article('article-' || :article::TEXT);
@@ -0,0 +1,2 @@
+\set viewer random(1, 50000)
+SELECT * FROM realworld.get_feed(:viewer, 20, 0);
@@ -0,0 +1,3 @@
+\set id random(1, 50000)
+\set viewer random(1, 50000)
+SELECT realworld.get_profile_by_username(('user' || :id::TEXT)::CITEXT, :viewer);
@@ -0,0 +1 @@
+SELECT realworld.get_tags();
@@ -0,0 +1,2 @@
+\set id random(1, 50000)
+SELECT realworld.get_user_by_id(:id);
@@ -0,0 +1,3 @@
+\set follower random(1, 50000)
+\set followed random(1, 50000)
+SELECT realworld.is_following(:follower, :followed);
@@ -0,0 +1,3 @@
+\set article random(1, 200000)
+SELECT * FROM realworld.get_article_id_by_slug('article-' || :article::TEXT);
+SELECT * FROM realworld.get_comments_from_article('article-' || :article::TEXT, NULL, 0, NULL, NULL);
@@ -0,0 +1,5 @@
+\set article random(1, 200000)
+\startpipeline
+SELECT * FROM realworld.get_article_id_by_slug('article-' || :article::TEXT);
+SELECT * FROM realworld.get_comments_from_article('article-' || :article::TEXT, NULL, 0, NULL, NULL);
+\endpipeline
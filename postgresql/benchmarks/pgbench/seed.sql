@@ -0,0 +1,174 @@
+-- Dataset for the pgbench scripts next to this file, one script per read
+-- function. Load it into a scratch database, the schema is recreated:
+--   psql -d realworld_bench -f postgresql/schemas/db_1.sql \
+--        -f postgresql/benchmarks/pgbench/seed.sql
+-- and run every script the way the service calls the functions, with
+-- prepared statements:
+--   for script in postgresql/benchmarks/pgbench/[gi]*.sql; do
+--     pgbench -n -M prepared -c 8 -j 8 -T 30 -f "$script" realworld_bench
+--   done
+-- The signatures are stable, so the same loop on an older checkout of
+-- db_1.sql gives the numbers to compare against.
+--
+-- writes/ has a script per write endpoint with the statements its handler
+-- sends, writes/round_trips/ the statements the handlers sent when every
+-- write was followed by a read; run those on a checkout of db_1.sql from
+-- before the write functions returned the row. The writes change the data,
+-- so reload the seed before each pass. Articles above 100000 are the ones
+-- deleted, the other scripts keep to the rest, and the follow scripts count
+-- with n through users no benchmark client already follows:
+--   for script in postgresql/benchmarks/pgbench/writes/*.sql; do
+--     rm -f pgbench_log.*
+--     pgbench -n -M prepared -c 8 -j 8 -t 2000 -D n=0 -l -f "$script" \
+--       realworld_bench
+--     cat pgbench_log.* | sort -n -k 3 | awk -v script="$script" \
+--       '{ us[NR] = $3 } END { print script, "p50", us[int(NR * 0.5)],
+--         "p99", us[int(NR * 0.99)] }'
+--   done
+--
+-- pipeline/ runs the two reads of GET /api/articles/{slug}/comments, the
+-- article lookup and the comments, one after another and in one pipeline.
+-- These are the round trips the handler waits for with
+-- REALWORLD_CONCURRENT_QUERIES_ENABLED off and on: on, the two statements
+-- go out at once on two connections and the request waits for one round
+-- trip like the pipelined script. Delay loopback traffic on the PostgreSQL
+-- host by 1ms each way and compare the latency average and stddev pgbench
+-- prints:
+--   sudo tc qdisc add dev lo root netem delay 1ms
+--   for script in postgresql/benchmarks/pgbench/pipeline/*.sql; do
+--     pgbench -n -M prepared -c 8 -j 8 -T 30 -f "$script" realworld_bench
+--   done
+--   sudo tc qdisc del dev lo root
+--
+-- tag_counters/ writes articles without tags, with two of the 1000 tags
+-- picked at random, and with the same two tags from every client, which
+-- then queue on the counter rows of realworld.tags until commit. Run them
+-- with the writes loop above; untagged.sql is the baseline without counter
+-- work, and a checkout of db_1.sql from before the tag counters gives the
+-- numbers to compare the other two against.
+--
+-- article_cache/ reads articles by slug with Zipf distributed popularity,
+-- the way GET /api/articles/:slug hits the database for a signed in reader:
+-- by_slug.sql reads the whole article, as on a cache miss, viewer_flags.sql
+-- only the flags, as on a hit. Anonymous hits skip the database. Weight the
+-- two by the hit ratio ArticleCacheZipfBenchmark reports for the configured
+-- capacity, about 88% for the default 64k articles, and compare with
+-- by_slug.sql alone:
+--   pgbench -n -M prepared -c 8 -j 8 -T 30 \
+--     -f postgresql/benchmarks/pgbench/article_cache/by_slug.sql \
+--     realworld_bench
+--   pgbench -n -M prepared -c 8 -j 8 -T 30 \
+--     -f postgresql/benchmarks/pgbench/article_cache/viewer_flags.sql@88 \
+--     -f postgresql/benchmarks/pgbench/article_cache/by_slug.sql@12 \
+--     realworld_bench
+
+-- 50k users, 200k articles, 1000 tags with 3 tags per article, 1M
+-- favorites, 20 followed authors per user, 200k comments
+INSERT INTO realworld.users(username, email, password_hash, bio, image)
+SELECT
+	'user' || i,
+	'user' || i || '@example.com',
+	'hash',
+	CASE WHEN i % 2 = 0 THEN 'bio of user ' || i END,
+	CASE WHEN i % 3 = 0 THEN 'https://example.com/' || i || '.jpg' END
+FROM
+	generate_series(1, 50000) AS i;
+
+INSERT INTO realworld.articles(title, slug, description, body, author_id,
+	created_at, updated_at)
+SELECT
+	'Article ' || i,
+	'article-' || i,
+	'Description of article ' || i,
+	repeat('Body of article ' || i || '. ', 20),
+	1 + (i::BIGINT * 7919) % 50000,
+	NOW() - make_interval(secs => 200000 - i),
+	NOW() - make_interval(secs => 200000 - i)
+FROM
+	generate_series(1, 200000) AS i;
+
+INSERT INTO realworld.tags(name)
+SELECT 'tag' || i FROM generate_series(1, 1000) AS i;
+
+INSERT INTO realworld.article_tags(article_id, tag_id)
+SELECT DISTINCT
+	a.article_id,
+	1 + (a.article_id * k * 31) % 1000
+FROM
+	realworld.articles AS a
+CROSS JOIN
+	generate_series(1, 3) AS k;
+
+-- What add_new_article would have written
+UPDATE realworld.articles AS a
+SET tag_list = ARRAY(
+	SELECT
+		t.name
+	FROM
+		realworld.article_tags AS at
+	INNER JOIN
+		realworld.tags AS t ON t.tag_id = at.tag_id
+	WHERE
+		at.article_id = a.article_id
+	ORDER BY
+		t.name);
+
+-- Bulk inserted tags bypass count_tag_articles, count them here
+UPDATE realworld.tags AS t
+SET articles_count = (
+	SELECT
+		COUNT(*)
+	FROM
+		realworld.article_tags AS at
+	WHERE
+		at.tag_id = t.tag_id);
+
+INSERT INTO realworld.favorites(user_id, article_id)
+SELECT DISTINCT
+	1 + (i::BIGINT * 104729) % 50000,
+	1 + (i::BIGINT * 7) % 200000
+FROM
+	generate_series(1, 1000000) AS i;
+
+INSERT INTO realworld.favorites_counters(article_id, shard, favorites_count)
+SELECT
+	article_id,
+	user_id % 16,
+	COUNT(*)
+FROM
+	realworld.favorites
+GROUP BY
+	article_id, user_id % 16;
+
+INSERT INTO realworld.followers(follower, followed)
+SELECT DISTINCT
+	u.user_id,
+	1 + (u.user_id * k * 7) % 50000
+FROM
+	realworld.users AS u
+CROSS JOIN
+	generate_series(1, 20) AS k
+WHERE
+	u.user_id <> 1 + (u.user_id * k * 7) % 50000;
+
+-- What follow() would have written
+INSERT INTO realworld.timelines(user_id, created_at, article_id, author_id)
+SELECT
+	f.follower,
+	a.created_at,
+	a.article_id,
+	a.author_id
+FROM
+	realworld.followers AS f
+INNER JOIN
+	realworld.articles AS a ON a.author_id = f.followed;
+
+INSERT INTO realworld.comments(author_id, article_id, body)
+SELECT
+	1 + (i * 31) % 50000,
+	1 + (i * 17) % 200000,
+	'Comment ' || i
+FROM
+	generate_series(1, 200000) AS i;
+
+VACUUM ANALYZE;
@@ -0,0 +1,4 @@
+\set author random(1, 50000)
+\set first_tag random(1, 1000)
+\set second_tag random(1, 1000)
+SELECT realworld.add_new_article('Benchmark article', 'bench-' || gen_random_uuid()::TEXT, 'Description', 'Body', :author, ARRAY['tag' || :first_tag, 'tag' || :second_tag]::VARCHAR(255)[]);
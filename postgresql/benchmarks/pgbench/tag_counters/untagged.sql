@@ -0,0 +1,2 @@
+\set author random(1, 50000)
+SELECT realworld.add_new_article('Benchmark article', 'bench-' || gen_random_uuid()::TEXT, 'Description', 'Body', :author, ARRAY[]::VARCHAR(255)[]);
@@ -0,0 +1,3 @@
+\set article random(100001, 200000)
+\set author 1 + (:article * 7919) % 50000
+SELECT realworld.delete_article_by_slug('article-' || :article::TEXT, :author);
@@ -0,0 +1,3 @@
+\set article random(1, 100000)
+\set author 1 + (:article * 7919) % 50000
+SELECT realworld.update_article_by_slug('article-' || :article::TEXT, :author, NULL, NULL, 'Updated description', NULL);
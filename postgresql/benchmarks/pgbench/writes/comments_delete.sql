@@ -0,0 +1,4 @@
+\set comment random(1, 200000)
+\set article 1 + (:comment * 17) % 200000
+\set author 1 + (:comment * 31) % 50000
+SELECT realworld.delete_comment(:comment, 'article-' || :article::TEXT, :author);
@@ -0,0 +1,3 @@
+\set article random(1, 100000)
+\set user random(1, 50000)
+SELECT realworld.add_comment_to_article('article-' || :article::TEXT, 'Benchmark comment', :user);
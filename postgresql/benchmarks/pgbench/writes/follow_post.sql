@@ -0,0 +1,3 @@
+\set n :n + 1
+\set follower 49999 - :client_id
+SELECT realworld.follow(:follower, ('user' || :n::TEXT)::CITEXT);
@@ -0,0 +1,3 @@
+\set author random(1, 50000)
+SELECT realworld.add_new_article('Benchmark article', 'bench-' || gen_random_uuid()::TEXT, 'Description', 'Body', :author, ARRAY['tag1', 'tag2']::VARCHAR(255)[]) AS article_id \gset
+SELECT realworld.get_article_with_author_profile(:article_id, :author);
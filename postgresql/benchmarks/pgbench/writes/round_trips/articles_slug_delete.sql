@@ -0,0 +1,4 @@
+\set article random(100001, 200000)
+\set author 1 + (:article * 7919) % 50000
+SELECT realworld.get_article_id_by_slug('article-' || :article::TEXT);
+SELECT realworld.delete_article_by_slug('article-' || :article::TEXT, :author);
@@ -0,0 +1,4 @@
+\set article random(1, 100000)
+\set author 1 + (:article * 7919) % 50000
+SELECT (article).article_id FROM realworld.update_article_by_slug('article-' || :article::TEXT, :author, NULL, NULL, 'Updated description', NULL) \gset
+SELECT realworld.get_article_with_author_profile(:article_id, :author);
@@ -0,0 +1,4 @@
+\set article random(1, 100000)
+\set user random(1, 50000)
+SELECT realworld.add_comment_to_article('article-' || :article::TEXT, 'Benchmark comment', :user) AS comment_id \gset
+SELECT realworld.get_comment(:comment_id, :user);
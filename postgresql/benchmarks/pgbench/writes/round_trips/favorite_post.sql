@@ -0,0 +1,5 @@
+\set article random(1, 100000)
+\set user random(1, 50000)
+SELECT realworld.get_article_id_by_slug('article-' || :article::TEXT) AS article_id \gset
+SELECT realworld.favorite_article('article-' || :article::TEXT, :user);
+SELECT realworld.get_article_with_author_profile(:article_id, :user);
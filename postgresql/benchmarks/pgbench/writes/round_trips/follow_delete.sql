@@ -0,0 +1,4 @@
+\set n :n + 1
+\set follower 49999 - :client_id
+SELECT (realworld.get_user_by_username(('user' || :n::TEXT)::CITEXT)).user_id AS followed \gset
+SELECT realworld.unfollow(:follower, :followed);
@@ -0,0 +1,195 @@
+-- Tag-filtered article list on 1M articles: containment on the tag_list
+-- array column against the former EXISTS join of article_tags and tags.
+--
+-- Run against a scratch database, the schema is dropped and recreated:
+--   psql -d realworld_bench -f postgresql/schemas/db_1.sql \
+--        -f postgresql/benchmarks/tag_filter.sql
+
+\timing on
+
+-- 10k users, 1M articles, 1000 tags with 1 to 3 tags per article picked
+-- with a power law: tag1 is on about a third of the articles, tag1000 on a
+-- few hundred
+INSERT INTO realworld.users(username, email, password_hash)
+SELECT
+	'user' || i,
+	'user' || i || '@example.com',
+	'hash'
+FROM
+	generate_series(1, 10000) AS i;
+
+INSERT INTO realworld.articles(title, slug, description, body, author_id,
+	created_at, updated_at)
+SELECT
+	'Article ' || i,
+	'article-' || i,
+	'Description of article ' || i,
+	'Body of article ' || i,
+	1 + (i::BIGINT * 7919) % 10000,
+	NOW() - make_interval(secs => 1000000 - i),
+	NOW() - make_interval(secs => 1000000 - i)
+FROM
+	generate_series(1, 1000000) AS i;
+
+INSERT INTO realworld.tags(name)
+SELECT 'tag' || i FROM generate_series(1, 1000) AS i;
+
+INSERT INTO realworld.article_tags(article_id, tag_id)
+SELECT DISTINCT
+	a.article_id,
+	1 + floor(1000 * power(random(), 3))::INT
+FROM
+	realworld.articles AS a
+CROSS JOIN
+	generate_series(1, 3) AS k;
+
+-- What add_new_article would have written
+UPDATE realworld.articles AS a
+SET tag_list = ARRAY(
+	SELECT
+		t.name
+	FROM
+		realworld.article_tags AS at
+	INNER JOIN
+		realworld.tags AS t ON t.tag_id = at.tag_id
+	WHERE
+		at.article_id = a.article_id
+	ORDER BY
+		t.name);
+
+-- Bulk inserted tags bypass count_tag_articles, count them here
+UPDATE realworld.tags AS t
+SET articles_count = (
+	SELECT
+		COUNT(*)
+	FROM
+		realworld.article_tags AS at
+	WHERE
+		at.tag_id = t.tag_id);
+
+VACUUM ANALYZE;
+
+SELECT
+	t.name,
+	COUNT(*) AS articles
+FROM
+	realworld.article_tags AS at
+INNER JOIN
+	realworld.tags AS t ON t.tag_id = at.tag_id
+WHERE
+	t.name IN ('tag1', 'tag100', 'tag1000')
+GROUP BY
+	t.name;
+
+-- The page query get_articles_with_author_profile ran before the column
+PREPARE join_tag_filter(VARCHAR(255), INT) AS
+SELECT
+	a.article_id
+FROM
+	realworld.articles AS a
+WHERE
+	EXISTS (
+		SELECT
+			1
+		FROM
+			realworld.article_tags AS at
+		INNER JOIN
+			realworld.tags AS t ON t.tag_id = at.tag_id
+		WHERE
+			at.article_id = a.article_id AND t.name = $1)
+ORDER BY
+	a.created_at DESC,
+	a.article_id DESC
+LIMIT
+	20
+OFFSET
+	$2;
+
+-- A popular, a median and a rare tag, a deep page and a tag no article has
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_tag_filter('tag1', 0);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(_tag => 'tag1');
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_tag_filter('tag100', 0);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(_tag => 'tag100');
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_tag_filter('tag1000', 0);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(_tag => 'tag1000');
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_tag_filter('tag100', 1000);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(
+	_tag => 'tag100', _offset => 1000);
+EXPLAIN (ANALYZE, BUFFERS) EXECUTE join_tag_filter('no such tag', 0);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT * FROM realworld.get_articles_with_author_profile(
+	_tag => 'no such tag');
+
+-- The column must give the same pages as the join
+SELECT
+	COUNT(*) AS wrong_page_rows
+FROM (
+	(SELECT article_id FROM realworld.get_articles_with_author_profile(
+		_tag => 'tag1000', _limit => 500)
+	EXCEPT ALL
+	SELECT article_id FROM (
+		SELECT
+			at.article_id,
+			a.created_at
+		FROM
+			realworld.article_tags AS at
+		INNER JOIN
+			realworld.tags AS t ON t.tag_id = at.tag_id
+		INNER JOIN
+			realworld.articles AS a ON a.article_id = at.article_id
+		WHERE
+			t.name = 'tag1000'
+		ORDER BY
+			a.created_at DESC,
+			a.article_id DESC
+		LIMIT
+			500) AS j)
+) AS diff;
+
+-- Every tag_list must be the sorted tags of its article
+SELECT
+	COUNT(*) AS wrong_tag_lists
+FROM
+	realworld.articles AS a
+WHERE
+	a.tag_list <> ARRAY(
+		SELECT
+			t.name
+		FROM
+			realworld.article_tags AS at
+		INNER JOIN
+			realworld.tags AS t ON t.tag_id = at.tag_id
+		WHERE
+			at.article_id = a.article_id
+		ORDER BY
+			t.name)::VARCHAR(255)[];
+
+-- Writing an article and retagging it keep both copies in sync
+BEGIN;
+SELECT article_id FROM realworld.add_new_article('Tagged', 'tagged', 'd', 'b',
+	1, ARRAY['tag5', 'tag3', 'tag5']::VARCHAR(255)[]);
+EXPLAIN (ANALYZE, BUFFERS)
+SELECT (article).article_id FROM realworld.update_article_by_slug('tagged', 1,
+	_tag_list => ARRAY['tag3', 'new tag']::VARCHAR(255)[]);
+SELECT tag_list FROM realworld.articles WHERE slug = 'tagged';
+SELECT realworld.get_article_tag_list(article_id)
+FROM realworld.articles WHERE slug = 'tagged';
+SELECT
+	t.name
+FROM
+	realworld.article_tags AS at
+INNER JOIN
+	realworld.tags AS t ON t.tag_id = at.tag_id
+INNER JOIN
+	realworld.articles AS a ON a.article_id = at.article_id
+WHERE
+	a.slug = 'tagged'
+ORDER BY
+	t.name;
+SELECT COUNT(*) AS wrong_tag_counters
+FROM realworld.get_tag_counter_mismatches();
+ROLLBACK;
@@ -10,6 +10,7 @@ CREATE TABLE IF NOT EXISTS realworld.users (
 	password_hash VARCHAR(255) NOT NULL,
 	bio TEXT,
 	image VARCHAR(255),
+	updated_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
 	CONSTRAINT pk_users PRIMARY KEY(user_id),
 	CONSTRAINT uniq_username UNIQUE(username),
 	CONSTRAINT uniq_email UNIQUE(email)
@@ -24,16 +25,26 @@ CREATE TABLE IF NOT EXISTS realworld.articles (
 	author_id INT NOT NULL,
 	created_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
 	updated_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
+	-- Sorted distinct tag names, a copy of article_tags written by
+	-- add_new_article and update_article_by_slug. Articles are rendered and
+	-- filtered by tag from it, article_tags serves the tag statistics.
+	tag_list VARCHAR(255)[] NOT NULL DEFAULT '{}',
 	CONSTRAINT pk_articles PRIMARY KEY(article_id),
 	CONSTRAINT fk_article_author FOREIGN KEY(author_id) REFERENCES realworld.users(user_id),
 	CONSTRAINT uniq_slug UNIQUE(slug)
 );
 
+-- articles_count and updated_at change whenever an article gets or loses
+-- the tag, updated_at is the watermark of the incremental updates of
+-- components::TagsCache
 CREATE TABLE IF NOT EXISTS realworld.tags (
 	tag_id SERIAL,
 	name VARCHAR(255),
+	articles_count INT NOT NULL DEFAULT 0,
+	updated_at TIMESTAMPTZ NOT NULL DEFAULT NOW(),
 	CONSTRAINT pk_tags PRIMARY KEY(tag_id),
-	CONSTRAINT uniq_name UNIQUE(name)
+	CONSTRAINT uniq_name UNIQUE(name),
+	CONSTRAINT check_articles_count CHECK(articles_count >= 0)
 );
 
 CREATE TABLE IF NOT EXISTS realworld.article_tags (
@@ -49,7 +60,20 @@ CREATE TABLE IF NOT EXISTS realworld.favorites (
 	article_id INT NOT NULL,
 	CONSTRAINT pk_favorites PRIMARY KEY(user_id, article_id),
 	CONSTRAINT fk_user FOREIGN KEY(user_id) REFERENCES realworld.users(user_id),
-	CONSTRAINT fk_article FOREIGN KEY(article_id) REFERENCES realworld.articles(article_id)
+	CONSTRAINT fk_article FOREIGN KEY(article_id) REFERENCES realworld.articles(article_id) ON DELETE CASCADE
+);
+
+-- Favorites per article, split into 16 shard rows so that
+-- concurrent favorites of a hot article do not queue on one row lock. The
+-- shard is user_id % 16: a user's favorite and unfavorite hit the same
+-- row, so every shard equals the favorites of its users and stays >= 0.
+CREATE TABLE IF NOT EXISTS realworld.favorites_counters (
+	article_id INT NOT NULL,
+	shard SMALLINT NOT NULL,
+	favorites_count BIGINT NOT NULL,
+	CONSTRAINT pk_favorites_counters PRIMARY KEY(article_id, shard),
+	CONSTRAINT fk_article FOREIGN KEY(article_id) REFERENCES realworld.articles(article_id) ON DELETE CASCADE,
+	CONSTRAINT check_favorites_count CHECK(favorites_count >= 0)
 );
 
 CREATE TABLE IF NOT EXISTS realworld.followers (
@@ -60,6 +84,39 @@ CREATE TABLE IF NOT EXISTS realworld.followers (
 	CONSTRAINT fk_followed FOREIGN KEY(followed) REFERENCES realworld.users(user_id)
 );
 
+-- The last follow or unfollow of every edge, written by follow and
+-- unfollow. Unfollows delete their followers row, so components::FollowGraph
+-- learns about them from here; changed_at is the watermark of its
+-- incremental updates, taken from clock_timestamp() so that the later of
+-- two writes of an edge, which queue on its row, has the later time.
+CREATE TABLE IF NOT EXISTS realworld.follow_changes (
+	follower INT NOT NULL,
+	followed INT NOT NULL,
+	following BOOL NOT NULL,
+	changed_at TIMESTAMPTZ NOT NULL,
+	CONSTRAINT pk_follow_changes PRIMARY KEY(follower, followed)
+);
+
+-- Personal feeds, filled when an article is written (fan-out on write).
+-- Rows exist only for current followers of the author: follow copies the
+-- author's articles in, unfollow and article deletion remove them, so the
+-- rows are found by primary key and need no foreign keys or extra indexes.
+CREATE TABLE IF NOT EXISTS realworld.timelines (
+	user_id INT NOT NULL,
+	created_at TIMESTAMPTZ NOT NULL,
+	article_id INT NOT NULL,
+	author_id INT NOT NULL,
+	CONSTRAINT pk_timelines PRIMARY KEY(user_id, created_at, article_id)
+);
+
+-- Authors whose articles are merged into feeds at read time instead, see
+-- realworld.timeline_max_fanout(). Once added an author is never removed.
+CREATE TABLE IF NOT EXISTS realworld.timeline_pull_authors (
+	author_id INT NOT NULL,
+	CONSTRAINT pk_timeline_pull_authors PRIMARY KEY(author_id),
+	CONSTRAINT fk_author FOREIGN KEY(author_id) REFERENCES realworld.users(user_id)
+);
+
 CREATE TABLE IF NOT EXISTS realworld.comments (
 	comment_id SERIAL,
 	author_id INT NOT NULL,
@@ -72,9 +129,32 @@ CREATE TABLE IF NOT EXISTS realworld.comments (
 	CONSTRAINT fk_author FOREIGN KEY(author_id) REFERENCES realworld.users(user_id) ON DELETE CASCADE
 );
 
-CREATE INDEX IF NOT EXISTS idx_users_username ON realworld.users(username);
-CREATE INDEX IF NOT EXISTS idx_articles_slug ON realworld.articles(slug);
-CREATE INDEX IF NOT EXISTS idx_articles_author_id ON realworld.articles(author_id);
+-- users(username), users(email), articles(slug) and the primary keys are
+-- indexed by their constraints. These serve the other access paths, see
+-- tests/test_query_plans.py.
+
+-- Incremental updates of the users cache
+CREATE INDEX IF NOT EXISTS idx_users_updated_at ON realworld.users(updated_at);
+-- Article lists and cursor pages, newest first
+CREATE INDEX IF NOT EXISTS idx_articles_created_at ON realworld.articles(created_at DESC, article_id DESC);
+-- Articles of an author: the author filter, pull authors of the feed and
+-- the copy on follow
+CREATE INDEX IF NOT EXISTS idx_articles_author_id_created_at ON realworld.articles(author_id, created_at DESC, article_id DESC);
+-- Tag filter
+CREATE INDEX IF NOT EXISTS idx_articles_tag_list ON realworld.articles USING GIN(tag_list);
+-- Articles of a tag in the statistics, and the reference check when a tag
+-- is deleted
+CREATE INDEX IF NOT EXISTS idx_article_tags_tag_id ON realworld.article_tags(tag_id, article_id);
+-- Incremental updates of the tags cache
+CREATE INDEX IF NOT EXISTS idx_tags_updated_at ON realworld.tags(updated_at);
+-- Favorites of an article, removed with it
+CREATE INDEX IF NOT EXISTS idx_favorites_article_id ON realworld.favorites(article_id);
+-- Followers of an author: fan-out and removal of an article from timelines
+CREATE INDEX IF NOT EXISTS idx_followers_followed ON realworld.followers(followed);
+-- Incremental updates of the follow graph
+CREATE INDEX IF NOT EXISTS idx_follow_changes_changed_at ON realworld.follow_changes(changed_at);
+-- Comments of an article, oldest first
+CREATE INDEX IF NOT EXISTS idx_comments_article_id_created_at ON realworld.comments(article_id, created_at, comment_id);
 
 CREATE TYPE realworld.realworld_user AS
 (
@@ -118,25 +198,61 @@ CREATE TYPE realworld.article_with_author_profile AS
 	author realworld.profile
 );
 
+-- Rows of the article lists and the feed: an article_with_author_profile
+-- and the author's id. author.following is FALSE, the handlers look the
+-- authors up in components::FollowGraph for the viewer.
+CREATE TYPE realworld.article_list_item AS
+(
+	article_id INT,
+	title VARCHAR(255),
+	slug VARCHAR(255),
+	description TEXT,
+	body TEXT,
+	created_at TIMESTAMP WITH TIME ZONE,
+	updated_at TIMESTAMP WITH TIME ZONE,
+	tag_list VARCHAR(255)[],
+	favorited BOOL,
+	favorites_count BIGINT,
+	author realworld.profile,
+	author_id INT
+);
+
+-- Rows of the comments of an article, the same way
+CREATE TYPE realworld.comment_list_item AS
+(
+	comment_id INT,
+	created_at TIMESTAMP WITH TIME ZONE,
+	updated_at TIMESTAMP WITH TIME ZONE,
+	body VARCHAR(16384),
+	author realworld.profile,
+	author_id INT
+);
+
 CREATE OR REPLACE FUNCTION realworld.add_comment_to_article(
 	_slug VARCHAR(255),
 	_body VARCHAR(16384),
 	_user_id INT)
-    RETURNS INT
+    RETURNS SETOF realworld.realworld_comment
 AS $$
 DECLARE
 	_comment_id INT;
 BEGIN
 	INSERT INTO
 		realworld.comments (body, author_id, article_id)
-	VALUES
-		(_body, _user_id, (SELECT article_id FROM realworld.articles WHERE slug = _slug))
+	SELECT
+		_body, _user_id, article_id
+	FROM
+		realworld.articles
+	WHERE
+		slug = _slug
 	RETURNING 
 		comment_id
 	INTO 
 		_comment_id;
 
-	RETURN _comment_id;
+	-- No row when there is no such article
+	RETURN QUERY
+	SELECT * FROM realworld.get_comment(_comment_id, _user_id);
 END;
 $$ LANGUAGE plpgsql;
 
@@ -147,24 +263,32 @@ CREATE OR REPLACE FUNCTION realworld.add_new_article(
 	_body TEXT,
 	_author_id INT,
 	_tag_list VARCHAR(255)[])
-    RETURNS INT
+    RETURNS SETOF realworld.article_with_author_profile
 AS $$
 DECLARE
 	_new_article_id INT;
 BEGIN
+	-- Serializes with follow and unfollow of the author, see fan_out_article
+	PERFORM 1 FROM realworld.users WHERE user_id = _author_id FOR NO KEY UPDATE;
+
 	INSERT INTO
-		realworld.articles (title, slug, description, body, author_id)
+		realworld.articles (title, slug, description, body, author_id, tag_list)
 	VALUES
-		(_title, _slug, _description, _body, _author_id)
+		(_title, _slug, _description, _body, _author_id,
+			ARRAY(SELECT DISTINCT t FROM unnest(_tag_list) AS t ORDER BY t))
 	RETURNING 
 		article_id INTO _new_article_id;
 
+	PERFORM realworld.fan_out_article(_new_article_id);
+
 	INSERT INTO 
 		realworld.tags(name)
 	SELECT 
 		unnest(_tag_list)
 	ON CONFLICT DO NOTHING;
 
+	PERFORM realworld.count_tag_articles(NULL, _tag_list);
+
 	INSERT INTO 
 		realworld.article_tags (article_id, tag_id)
 	SELECT 
@@ -177,7 +301,8 @@ BEGIN
 		WHERE 
 			name = ANY (_tag_list)) AS tag_ids;
 
-	RETURN _new_article_id;
+	RETURN QUERY
+	SELECT * FROM realworld.get_article_with_author_profile(_new_article_id, _author_id);
 END;
 $$ LANGUAGE plpgsql;
 
@@ -203,30 +328,81 @@ BEGIN
 END;
 $$ LANGUAGE plpgsql;
 
+-- Counts an article out of the tags it lost and into the tags it got, and
+-- moves them past the watermark of the tags cache. The rows are locked in
+-- name order, so article writes sharing tags cannot deadlock.
+CREATE OR REPLACE FUNCTION realworld.count_tag_articles(
+	_old_tag_list VARCHAR(255)[],
+	_new_tag_list VARCHAR(255)[])
+    RETURNS VOID
+AS $$
+BEGIN
+	PERFORM 1 FROM realworld.tags WHERE name = ANY (_old_tag_list || _new_tag_list) ORDER BY name FOR NO KEY UPDATE;
+
+	UPDATE
+		realworld.tags
+	SET
+		articles_count = articles_count +
+			(name = ANY (COALESCE(_new_tag_list, '{}')))::INT -
+			(name = ANY (COALESCE(_old_tag_list, '{}')))::INT,
+		updated_at = NOW()
+	WHERE
+		name = ANY (_old_tag_list || _new_tag_list) AND
+		(name = ANY (COALESCE(_new_tag_list, '{}'))) <> (name = ANY (COALESCE(_old_tag_list, '{}')));
+END;
+$$ LANGUAGE plpgsql;
+
+-- TRUE when the article is deleted, FALSE when it belongs to another
+-- author and no row when there is no such article
 CREATE OR REPLACE FUNCTION realworld.delete_article_by_slug(
 	_slug VARCHAR(255),
 	_author_id INT)
-    RETURNS VOID
+    RETURNS SETOF BOOL
 AS $$
 DECLARE 
-	_deleted_rows_count INT;
+	_article_id INT;
+	_created_at TIMESTAMPTZ;
+	_tag_list VARCHAR(255)[];
 BEGIN
+	PERFORM 1 FROM realworld.users WHERE user_id = _author_id FOR NO KEY UPDATE;
+
 	DELETE FROM
 		realworld.articles
 	WHERE
 		slug = _slug AND
-		author_id = _author_id;	
+		author_id = _author_id
+	RETURNING
+		article_id, created_at, tag_list
+	INTO
+		_article_id, _created_at, _tag_list;
+
+	IF _article_id IS NULL THEN
+		RETURN QUERY
+		SELECT FALSE FROM realworld.articles WHERE slug = _slug;
+		RETURN;
+	END IF;
+
+	PERFORM realworld.count_tag_articles(_tag_list, NULL);
+
+	DELETE FROM
+		realworld.timelines
+	WHERE
+		user_id IN (SELECT follower FROM realworld.followers WHERE followed = _author_id) AND
+		created_at = _created_at AND
+		article_id = _article_id;
+
+	RETURN NEXT TRUE;
 END;
 $$ LANGUAGE plpgsql;
 
+-- TRUE when the comment is deleted, FALSE when it belongs to another
+-- author and no row when the article has no such comment
 CREATE OR REPLACE FUNCTION realworld.delete_comment(
 	_comment_id INT,
 	_slug VARCHAR(255),
 	_author_id INT)
-    RETURNS VOID
+    RETURNS SETOF BOOL
 AS $$
-DECLARE
-	_deleted_rows_count INT;
 BEGIN
 	DELETE FROM
 		realworld.comments
@@ -234,70 +410,153 @@ BEGIN
 		comment_id = _comment_id AND
 		author_id = _author_id AND
 		article_id = (SELECT article_id FROM realworld.articles WHERE slug = _slug);
+
+	IF FOUND THEN
+		RETURN NEXT TRUE;
+		RETURN;
+	END IF;
+
+	RETURN QUERY
+	SELECT
+		FALSE
+	FROM
+		realworld.comments
+	WHERE
+		comment_id = _comment_id AND
+		article_id = (SELECT article_id FROM realworld.articles WHERE slug = _slug);
 END;
 $$ LANGUAGE plpgsql;
 
-CREATE OR REPLACE FUNCTION realworld.is_comment_exist(
-	_comment_id INT,
-	_slug VARCHAR(255),
-	_author_id INT)
-		RETURNS BOOL
+-- Adds the article to the timelines of the author's followers. An author
+-- with more than timeline_max_fanout() followers becomes a pull author
+-- instead. Callers hold a lock on the author's users row so that a
+-- concurrent follow sees the article or the article sees the follow.
+CREATE OR REPLACE FUNCTION realworld.fan_out_article(
+	_article_id INT)
+    RETURNS VOID
 AS $$
+DECLARE
+	_author_id INT;
+	_created_at TIMESTAMPTZ;
 BEGIN
-	RETURN
-	EXISTS(
-		SELECT
-			1
-		FROM
-			realworld.comments
-		WHERE
-			comment_id = _comment_id AND
-			author_id = _author_id AND
-			article_id = (SELECT article_id FROM realworld.articles WHERE slug = _slug)
-	);
+	SELECT
+		author_id, created_at
+	INTO
+		_author_id, _created_at
+	FROM
+		realworld.articles
+	WHERE
+		article_id = _article_id;
+
+	IF EXISTS (SELECT 1 FROM realworld.timeline_pull_authors WHERE author_id = _author_id) THEN
+		RETURN;
+	END IF;
+
+	IF (SELECT COUNT(*) FROM (
+			SELECT
+				1
+			FROM
+				realworld.followers
+			WHERE
+				followed = _author_id
+			LIMIT
+				realworld.timeline_max_fanout() + 1) AS f) > realworld.timeline_max_fanout() THEN
+		INSERT INTO
+			realworld.timeline_pull_authors (author_id)
+		VALUES
+			(_author_id)
+		ON CONFLICT DO NOTHING;
+		RETURN;
+	END IF;
+
+	INSERT INTO
+		realworld.timelines (user_id, created_at, article_id, author_id)
+	SELECT
+		follower, _created_at, _article_id, _author_id
+	FROM
+		realworld.followers
+	WHERE
+		followed = _author_id
+	ON CONFLICT DO NOTHING;
 END;
 $$ LANGUAGE plpgsql;
 
+-- No row when there is no such article
 CREATE OR REPLACE FUNCTION realworld.favorite_article(
 	_slug VARCHAR(255),
 	_user_id INT)
-    RETURNS VOID
+    RETURNS SETOF realworld.article_with_author_profile
 AS $$
+DECLARE
+	_article_id INT;
 BEGIN
+	SELECT article_id INTO _article_id FROM realworld.articles WHERE slug = _slug;
+	IF _article_id IS NULL THEN
+		RETURN;
+	END IF;
+
 	INSERT INTO
 		realworld.favorites (user_id, article_id)
 	VALUES
-		(_user_id, (SELECT article_id FROM realworld.articles WHERE slug = _slug));
+		(_user_id, _article_id)
+	ON CONFLICT DO NOTHING;
+
+	-- Only a new favorite is counted, so favoriting twice is a no-op
+	IF FOUND THEN
+		INSERT INTO
+			realworld.favorites_counters (article_id, shard, favorites_count)
+		VALUES
+			(_article_id, _user_id % 16, 1)
+		ON CONFLICT (article_id, shard) DO UPDATE SET
+			favorites_count = realworld.favorites_counters.favorites_count + 1;
+	END IF;
+
+	RETURN QUERY
+	SELECT * FROM realworld.get_article_with_author_profile(_article_id, _user_id);
 END;
 $$ LANGUAGE plpgsql;
 
+-- The followed user, the time of the change in follow_changes and their
+-- profile. No row when there is no such user.
 CREATE OR REPLACE FUNCTION realworld.follow(
 	_follower INT,
-	_followed INT)
-    RETURNS VOID
+	_username CITEXT)
+    RETURNS TABLE(user_id INT, changed_at TIMESTAMPTZ, profile realworld.profile)
 AS $$
+DECLARE
+	_followed INT;
+	_changed_at TIMESTAMPTZ;
 BEGIN
+	SELECT u.user_id INTO _followed FROM realworld.users AS u WHERE u.username = _username FOR SHARE;
+	IF _followed IS NULL THEN
+		RETURN;
+	END IF;
+	-- Locks the edge first, so that a follow and an unfollow of it run one
+	-- after the other in the order of their changed_at
+	_changed_at := realworld.log_follow_change(_follower, _followed, TRUE);
+
 	INSERT INTO 
 		realworld.followers(follower, followed)
 	VALUES
-		(_follower, _followed);
-END;
-$$ LANGUAGE plpgsql;
+		(_follower, _followed)
+	ON CONFLICT DO NOTHING;
+
+	-- Following twice is a no-op, the timeline is already filled
+	IF FOUND THEN
+		INSERT INTO
+			realworld.timelines (user_id, created_at, article_id, author_id)
+		SELECT
+			_follower, created_at, article_id, author_id
+		FROM
+			realworld.articles
+		WHERE
+			author_id = _followed AND
+			NOT EXISTS (SELECT 1 FROM realworld.timeline_pull_authors WHERE author_id = _followed)
+		ON CONFLICT DO NOTHING;
+	END IF;
 
-CREATE OR REPLACE FUNCTION realworld.get_article_id_by_slug(
-	_slug VARCHAR(255))
-    RETURNS SETOF INT 
-AS $$
-DECLARE
-	_article_id INT;
-BEGIN
 	RETURN QUERY
-	SELECT
-		article_id
-	FROM
-		realworld.articles
-	WHERE
-		slug = _slug;
+	SELECT _followed, _changed_at, p FROM realworld.get_profile(_followed, _follower) AS p;
 END;
 $$ LANGUAGE plpgsql;
 
@@ -305,76 +564,137 @@ CREATE OR REPLACE FUNCTION realworld.get_article_tag_list(
 	_article_id INT)
     RETURNS SETOF VARCHAR(255) 
 AS $$
-BEGIN
-RETURN QUERY
 	SELECT 
-		t.name
+		unnest(tag_list)
 	FROM 
-		realworld.article_tags AS at
-	INNER JOIN 
-		realworld.tags AS t ON t.tag_id = at.tag_id
+		realworld.articles
 	WHERE 
-		article_id = _article_id
-	ORDER BY
-		t.name ASC;
-END;
-$$ LANGUAGE plpgsql;
+		article_id = _article_id;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- The viewer columns of an article_with_author_profile, for articles cached
+-- without them. No row when there is no such article.
+CREATE OR REPLACE FUNCTION realworld.get_article_viewer_flags(
+	_article_id INT,
+	_user_id INT)
+    RETURNS TABLE(favorited BOOL, following BOOL)
+AS $$
+	SELECT
+		EXISTS (
+			SELECT
+				1
+			FROM
+				realworld.favorites AS f
+			WHERE
+				f.user_id = _user_id AND f.article_id = a.article_id),
+		EXISTS (
+			SELECT
+				1
+			FROM
+				realworld.followers AS f
+			WHERE
+				f.follower = _user_id AND f.followed = a.author_id)
+	FROM
+		realworld.articles AS a
+	WHERE
+		a.article_id = _article_id;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- Whether an article exists, read alongside its comments. No row when
+-- there is no such article.
+CREATE OR REPLACE FUNCTION realworld.get_article_id_by_slug(
+	_slug VARCHAR(255))
+    RETURNS SETOF INT
+AS $$
+	SELECT
+		article_id
+	FROM
+		realworld.articles
+	WHERE
+		slug = _slug;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_article_with_author_profile(
 	_id INT,
 	_follower_id INT = NULL)
     RETURNS SETOF realworld.article_with_author_profile 
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT
-		article_id,
-		title,
-		slug,
-		description,	
-		body,
-		created_at,
-		updated_at,
-		ARRAY(SELECT * FROM realworld.get_article_tag_list(_id))::VARCHAR(255)[],
-		realworld.is_favorited_article(_id, _follower_id),
-		(SELECT COUNT(*) FROM realworld.favorites WHERE article_id = _id),
-		realworld.get_profile(author_id, _follower_id)
+		a.article_id,
+		a.title,
+		a.slug,
+		a.description,
+		a.body,
+		a.created_at,
+		a.updated_at,
+		a.tag_list,
+		EXISTS (
+			SELECT
+				1
+			FROM
+				realworld.favorites AS f
+			WHERE
+				f.user_id = _follower_id AND f.article_id = a.article_id),
+		(SELECT COALESCE(SUM(c.favorites_count), 0)::BIGINT FROM realworld.favorites_counters AS c WHERE c.article_id = a.article_id),
+		ROW(
+			u.username,
+			u.bio,
+			u.image,
+			EXISTS (
+				SELECT
+					1
+				FROM
+					realworld.followers AS f
+				WHERE
+					f.follower = _follower_id AND f.followed = a.author_id))::realworld.profile
 	FROM
-		realworld.articles
+		realworld.articles AS a
+	INNER JOIN
+		realworld.users AS u ON u.user_id = a.author_id
 	WHERE
-		article_id = _id;
-END;
-$$ LANGUAGE plpgsql;
+		a.article_id = _id;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_article_with_author_profile_by_slug(
 	_slug VARCHAR(255),
 	_follower_id INT = NULL)
     RETURNS SETOF realworld.article_with_author_profile 
 AS $$
-DECLARE
-	_article_id INT;
-BEGIN
-	SELECT article_id FROM realworld.articles WHERE slug = _slug INTO _article_id;
-	
-	RETURN QUERY
 	SELECT
-		article_id,
-		title,
-		slug,
-		description,	
-		body,
-		created_at,
-		updated_at,
-		ARRAY(SELECT * FROM realworld.get_article_tag_list(_article_id))::VARCHAR(255)[],
-		realworld.is_favorited_article(_article_id, _follower_id),
-		(SELECT COUNT(*) FROM realworld.favorites WHERE article_id = _article_id),
-		realworld.get_profile(author_id, _follower_id)
+		a.article_id,
+		a.title,
+		a.slug,
+		a.description,
+		a.body,
+		a.created_at,
+		a.updated_at,
+		a.tag_list,
+		EXISTS (
+			SELECT
+				1
+			FROM
+				realworld.favorites AS f
+			WHERE
+				f.user_id = _follower_id AND f.article_id = a.article_id),
+		(SELECT COALESCE(SUM(c.favorites_count), 0)::BIGINT FROM realworld.favorites_counters AS c WHERE c.article_id = a.article_id),
+		ROW(
+			u.username,
+			u.bio,
+			u.image,
+			EXISTS (
+				SELECT
+					1
+				FROM
+					realworld.followers AS f
+				WHERE
+					f.follower = _follower_id AND f.followed = a.author_id))::realworld.profile
 	FROM
-		realworld.articles
+		realworld.articles AS a
+	INNER JOIN
+		realworld.users AS u ON u.user_id = a.author_id
 	WHERE
-		article_id = _article_id;
-END;
-$$ LANGUAGE plpgsql;
+		a.slug = _slug;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_articles_with_author_profile(
 	_tag VARCHAR(255) = NULL,
@@ -382,206 +702,470 @@ CREATE OR REPLACE FUNCTION realworld.get_articles_with_author_profile(
 	_favorited_by_user CITEXT = NULL,
 	_user_id INT = NULL,
 	_limit INT = 20,
-	_offset INT = 0)
-    RETURNS SETOF realworld.article_with_author_profile 
+	_offset INT = 0,
+	_cursor_created_at TIMESTAMPTZ = NULL,
+	_cursor_article_id INT = NULL)
+    RETURNS SETOF realworld.article_list_item
 AS $$
-BEGIN
-	RETURN QUERY
-	SELECT 
-		article_id,
-		title,
-		slug,
-		description,	
-		body,
-		created_at,
-		updated_at,
-		ARRAY(SELECT * FROM realworld.get_article_tag_list(article_id))::VARCHAR(255)[],
-		realworld.is_favorited_article(article_id),
-		(SELECT 
-			COUNT(*) 
-		FROM 
-			realworld.favorites 
-		WHERE 
-			realworld.favorites.article_id = realworld.articles.article_id),
-		realworld.get_profile(realworld.articles.author_id, _user_id)
-	FROM 
-		realworld.articles
-	INNER JOIN 
-		realworld.users ON realworld.articles.author_id = realworld.users.user_id
-	WHERE 
-		(_tag IS NULL OR
-		article_id IN (
-			SELECT 
-				article_id 
-			FROM 
-				realworld.article_tags
-			INNER JOIN 
-				realworld.tags ON realworld.article_tags.tag_id = realworld.tags.tag_id 
-			WHERE 
-				realworld.tags.name = _tag)) AND	
-		(_author_username IS NULL OR realworld.users.username = _author_username) AND
-		(_favorited_by_user IS NULL OR
-		article_id IN (
-			SELECT 
-				article_id 
-			FROM 
-				realworld.favorites
-			INNER JOIN 
-				realworld.users ON realworld.favorites.user_id = realworld.users.user_id
-			WHERE 
-				realworld.users.username = _favorited_by_user))
-	ORDER BY realworld.articles.created_at DESC
-	LIMIT 
-		(CASE WHEN _limit IS NULL THEN 20 ELSE _limit END)
-	OFFSET 
-		(CASE WHEN _offset IS NULL THEN 0 ELSE _offset END);
-END;
-$$ LANGUAGE plpgsql;
+	-- The page is picked first, favorites and the author profile are then
+	-- joined to at most _limit rows
+	WITH page AS (
+		SELECT
+			a.article_id,
+			a.title,
+			a.slug,
+			a.description,
+			a.body,
+			a.created_at,
+			a.updated_at,
+			a.tag_list,
+			a.author_id
+		FROM
+			realworld.articles AS a
+		WHERE
+			(_tag IS NULL OR a.tag_list @> ARRAY[_tag]) AND
+			(_author_username IS NULL OR a.author_id = (
+				SELECT
+					user_id
+				FROM
+					realworld.users
+				WHERE
+					username = _author_username)) AND
+			(_favorited_by_user IS NULL OR EXISTS (
+				SELECT
+					1
+				FROM
+					realworld.favorites AS f
+				INNER JOIN
+					realworld.users AS u ON u.user_id = f.user_id
+				WHERE
+					f.article_id = a.article_id AND u.username = _favorited_by_user)) AND
+			(_cursor_created_at IS NULL OR
+				(a.created_at, a.article_id) < (_cursor_created_at, _cursor_article_id))
+		ORDER BY
+			a.created_at DESC,
+			a.article_id DESC
+		LIMIT
+			COALESCE(_limit, 20)
+		OFFSET
+			COALESCE(_offset, 0)
+	),
+	viewer_favorites AS (
+		SELECT
+			article_id
+		FROM
+			realworld.favorites
+		WHERE
+			user_id = _user_id AND article_id IN (SELECT article_id FROM page)
+	)
+	SELECT
+		page.article_id,
+		page.title,
+		page.slug,
+		page.description,
+		page.body,
+		page.created_at,
+		page.updated_at,
+		page.tag_list,
+		viewer_favorites.article_id IS NOT NULL,
+		favorites.favorites_count,
+		ROW(
+			users.username,
+			users.bio,
+			users.image,
+			FALSE)::realworld.profile,
+		page.author_id
+	FROM
+		page
+	INNER JOIN
+		realworld.users AS users ON users.user_id = page.author_id
+	LEFT JOIN
+		viewer_favorites ON viewer_favorites.article_id = page.article_id
+	CROSS JOIN LATERAL (
+		SELECT
+			COALESCE(SUM(c.favorites_count), 0)::BIGINT AS favorites_count
+		FROM
+			realworld.favorites_counters AS c
+		WHERE
+			c.article_id = page.article_id
+	) AS favorites
+	ORDER BY
+		page.created_at DESC,
+		page.article_id DESC;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_comment(
 	_comment_id INT,
 	_user_id INT = NULL)
     RETURNS SETOF realworld.realworld_comment 
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT
 		comments.comment_id,
 		comments.created_at,
 		comments.updated_at,
 		comments.body,
-		realworld.get_profile(comments.author_id, _user_id)
+		ROW(
+			users.username,
+			users.bio,
+			users.image,
+			EXISTS (
+				SELECT
+					1
+				FROM
+					realworld.followers AS f
+				WHERE
+					f.follower = _user_id AND f.followed = comments.author_id))::realworld.profile
 	FROM
 		realworld.comments AS comments
 	INNER JOIN 
 		realworld.articles AS articles ON articles.article_id = comments.article_id
+	INNER JOIN
+		realworld.users AS users ON users.user_id = comments.author_id
 	WHERE
 		comments.comment_id = _comment_id;
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
+-- Oldest first, all of them when _limit is NULL
 CREATE OR REPLACE FUNCTION realworld.get_comments_from_article(
 	_slug VARCHAR(255),
-	_user_id INT = NULL)
-    RETURNS SETOF realworld.realworld_comment 
+	_limit INT = NULL,
+	_offset INT = 0,
+	_cursor_created_at TIMESTAMPTZ = NULL,
+	_cursor_comment_id INT = NULL)
+    RETURNS SETOF realworld.comment_list_item
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT
 		comments.comment_id,
 		comments.created_at,
 		comments.updated_at,
 		comments.body,
-		realworld.get_profile(comments.author_id, _user_id)
+		ROW(
+			users.username,
+			users.bio,
+			users.image,
+			FALSE)::realworld.profile,
+		comments.author_id
 	FROM
 		realworld.comments AS comments
 	INNER JOIN 
 		realworld.articles AS articles ON articles.article_id = comments.article_id
+	INNER JOIN
+		realworld.users AS users ON users.user_id = comments.author_id
 	WHERE
-		articles.slug = _slug;
-END;
-$$ LANGUAGE plpgsql;
+		articles.slug = _slug AND
+		(_cursor_created_at IS NULL OR
+			(comments.created_at, comments.comment_id) > (_cursor_created_at, _cursor_comment_id))
+	ORDER BY
+		comments.created_at,
+		comments.comment_id
+	LIMIT
+		_limit
+	OFFSET
+		COALESCE(_offset, 0);
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- Counter shards that differ from the favorites they count, must be empty
+CREATE OR REPLACE FUNCTION realworld.get_favorites_counter_mismatches()
+	RETURNS TABLE (
+		article_id INT,
+		shard SMALLINT,
+		stored BIGINT,
+		actual BIGINT
+	)
+AS $$
+	SELECT
+		COALESCE(c.article_id, f.article_id),
+		COALESCE(c.shard, f.shard),
+		COALESCE(c.favorites_count, 0),
+		COALESCE(f.favorites_count, 0)
+	FROM
+		realworld.favorites_counters AS c
+	FULL JOIN (
+		SELECT
+			favorites.article_id,
+			(favorites.user_id % 16)::SMALLINT AS shard,
+			COUNT(*) AS favorites_count
+		FROM
+			realworld.favorites
+		GROUP BY
+			favorites.article_id, favorites.user_id % 16
+	) AS f ON f.article_id = c.article_id AND f.shard = c.shard
+	WHERE
+		COALESCE(c.favorites_count, 0) <> COALESCE(f.favorites_count, 0);
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_feed(
 	_user_id INT,
 	_limit INT = 20,
-	_offset INT = 0)
-    RETURNS SETOF realworld.article_with_author_profile 
+	_offset INT = 0,
+	_cursor_created_at TIMESTAMPTZ = NULL,
+	_cursor_article_id INT = NULL)
+    RETURNS SETOF realworld.article_list_item
 AS $$
-BEGIN
-	RETURN QUERY
-	SELECT 
-		article_id,
-		title,
-		slug,
-		description,	
-		body,
-		created_at,
-		updated_at,
-		ARRAY(SELECT * FROM realworld.get_article_tag_list(article_id))::VARCHAR(255)[],
-		realworld.is_favorited_article(article_id),
-		(SELECT COUNT(*) FROM realworld.favorites WHERE article_id = article_id),
-		realworld.get_profile(author_id, _user_id)
-	FROM 
-		realworld.articles
+	-- Same shape as get_articles_with_author_profile. Candidates are the
+	-- first rows of the timeline and of every followed pull author, the page
+	-- is taken from their merge.
+	WITH entries AS (
+		(
+			SELECT
+				t.article_id,
+				t.created_at
+			FROM
+				realworld.timelines AS t
+			WHERE
+				t.user_id = _user_id AND
+				(_cursor_created_at IS NULL OR
+					(t.created_at, t.article_id) < (_cursor_created_at, _cursor_article_id)) AND
+				-- Rows written before the author became a pull author
+				NOT EXISTS (
+					SELECT
+						1
+					FROM
+						realworld.timeline_pull_authors AS p
+					WHERE
+						p.author_id = t.author_id)
+			ORDER BY
+				t.created_at DESC,
+				t.article_id DESC
+			LIMIT
+				COALESCE(_limit, 20) + COALESCE(_offset, 0)
+		)
+		UNION ALL
+		SELECT
+			pulled.article_id,
+			pulled.created_at
+		FROM
+			realworld.followers AS f
+		INNER JOIN
+			realworld.timeline_pull_authors AS p ON p.author_id = f.followed
+		CROSS JOIN LATERAL (
+			SELECT
+				a.article_id,
+				a.created_at
+			FROM
+				realworld.articles AS a
+			WHERE
+				a.author_id = f.followed AND
+				(_cursor_created_at IS NULL OR
+					(a.created_at, a.article_id) < (_cursor_created_at, _cursor_article_id))
+			ORDER BY
+				a.created_at DESC,
+				a.article_id DESC
+			LIMIT
+				COALESCE(_limit, 20) + COALESCE(_offset, 0)
+		) AS pulled
+		WHERE
+			f.follower = _user_id
+	),
+	page AS (
+		SELECT
+			a.article_id,
+			a.title,
+			a.slug,
+			a.description,
+			a.body,
+			a.created_at,
+			a.updated_at,
+			a.tag_list,
+			a.author_id
+		FROM (
+			SELECT
+				article_id,
+				created_at
+			FROM
+				entries
+			ORDER BY
+				created_at DESC,
+				article_id DESC
+			LIMIT
+				COALESCE(_limit, 20)
+			OFFSET
+				COALESCE(_offset, 0)
+		) AS e
+		INNER JOIN
+			realworld.articles AS a ON a.article_id = e.article_id
+	),
+	viewer_favorites AS (
+		SELECT
+			article_id
+		FROM
+			realworld.favorites
+		WHERE
+			user_id = _user_id AND article_id IN (SELECT article_id FROM page)
+	)
+	SELECT
+		page.article_id,
+		page.title,
+		page.slug,
+		page.description,
+		page.body,
+		page.created_at,
+		page.updated_at,
+		page.tag_list,
+		viewer_favorites.article_id IS NOT NULL,
+		favorites.favorites_count,
+		ROW(users.username, users.bio, users.image, FALSE)::realworld.profile,
+		page.author_id
+	FROM
+		page
+	INNER JOIN
+		realworld.users AS users ON users.user_id = page.author_id
+	LEFT JOIN
+		viewer_favorites ON viewer_favorites.article_id = page.article_id
+	CROSS JOIN LATERAL (
+		SELECT
+			COALESCE(SUM(c.favorites_count), 0)::BIGINT AS favorites_count
+		FROM
+			realworld.favorites_counters AS c
+		WHERE
+			c.article_id = page.article_id
+	) AS favorites
+	ORDER BY
+		page.created_at DESC,
+		page.article_id DESC;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- A page of follower edges after (_after_follower, _after_followed) in
+-- primary key order, for loading the follow graph in chunks
+CREATE OR REPLACE FUNCTION realworld.get_follower_edges(
+	_after_follower INT,
+	_after_followed INT,
+	_limit INT)
+    RETURNS TABLE(follower INT, followed INT)
+AS $$
+	SELECT
+		f.follower,
+		f.followed
+	FROM
+		realworld.followers AS f
 	WHERE
-		author_id IN (
-			SELECT followed FROM realworld.followers WHERE follower = _user_id
-		)		
-	ORDER BY created_at DESC
+		(f.follower, f.followed) > (_after_follower, _after_followed)
+	ORDER BY
+		f.follower,
+		f.followed
 	LIMIT
-		_limit
-	OFFSET
-		_offset;
-END;
-$$ LANGUAGE plpgsql;
+		_limit;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- Edges followed or unfollowed after _changed_after, in their current state
+CREATE OR REPLACE FUNCTION realworld.get_follow_changes(
+	_changed_after TIMESTAMPTZ)
+    RETURNS TABLE(follower INT, followed INT, following BOOL, changed_at TIMESTAMPTZ)
+AS $$
+	SELECT
+		c.follower,
+		c.followed,
+		c.following,
+		c.changed_at
+	FROM
+		realworld.follow_changes AS c
+	WHERE
+		c.changed_at > _changed_after;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- The latest changed_at in follow_changes, the epoch when it is empty
+CREATE OR REPLACE FUNCTION realworld.get_follow_changes_watermark()
+    RETURNS TIMESTAMPTZ
+AS $$
+	SELECT
+		COALESCE(MAX(changed_at), TIMESTAMPTZ 'epoch')
+	FROM
+		realworld.follow_changes;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_profile(
 	_id INT,
 	_follower_id INT = NULL)
     RETURNS SETOF realworld.profile 
 AS $$
-BEGIN
-RETURN QUERY
 	SELECT 
 		username, 
 		bio, 
 		image, 
-		CASE WHEN _follower_id = NULL THEN
+		CASE WHEN _follower_id IS NULL THEN
 			FALSE
 		ELSE
-			 realworld.is_following(_follower_id, _id)
+			EXISTS (
+				SELECT
+					1
+				FROM
+					realworld.followers
+				WHERE
+					follower = _follower_id AND followed = _id)
 		END
 	FROM 
 		realworld.users
 	WHERE 
 		user_id = _id;
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_profile_by_username(
 	_username CITEXT,
 	_follower_id INT = NULL)
     RETURNS SETOF realworld.profile 
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT 
 		username, 
 		bio, 
 		image, 
-		CASE WHEN _follower_id = NULL THEN
+		CASE WHEN _follower_id IS NULL THEN
 			FALSE
 		ELSE
-			 realworld.is_following(_follower_id, user_id)
+			EXISTS (
+				SELECT
+					1
+				FROM
+					realworld.followers
+				WHERE
+					follower = _follower_id AND followed = users.user_id)
 		END
 	FROM 
 		realworld.users
 	WHERE 
 		username = _username;
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
-CREATE OR REPLACE FUNCTION realworld.get_tags()
-    RETURNS SETOF VARCHAR(255) 
+-- Tags whose counter differs from the articles that have them, must be empty
+CREATE OR REPLACE FUNCTION realworld.get_tag_counter_mismatches()
+	RETURNS TABLE (
+		name VARCHAR(255),
+		stored INT,
+		actual BIGINT
+	)
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT
-		name
+		t.name,
+		t.articles_count,
+		COUNT(at.article_id)
 	FROM
-		realworld.article_tags AS at
-	INNER JOIN
-		realworld.tags AS t ON t.tag_id = at.tag_id;
-END;
-$$ LANGUAGE plpgsql;
+		realworld.tags AS t
+	LEFT JOIN
+		realworld.article_tags AS at ON at.tag_id = t.tag_id
+	GROUP BY
+		t.tag_id
+	HAVING
+		t.articles_count <> COUNT(at.article_id);
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- Every tag, or the tags touched after _updated_after, with the number of
+-- articles that have it
+CREATE OR REPLACE FUNCTION realworld.get_tags(
+	_updated_after TIMESTAMPTZ = NULL)
+    RETURNS TABLE(name VARCHAR(255), articles_count INT)
+AS $$
+	SELECT
+		name,
+		articles_count
+	FROM
+		realworld.tags
+	WHERE
+		_updated_after IS NULL OR updated_at > _updated_after;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_user_by_email(
 	_email VARCHAR(255))
     RETURNS SETOF realworld.realworld_user 
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT 
 		user_id, 
 		username, 
@@ -593,15 +1177,12 @@ BEGIN
 		realworld.users
 	WHERE 
 		email = _email;
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_user_by_id(
 	_user_id INT)
     RETURNS SETOF realworld.realworld_user 
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT 
 		user_id, 
 		username, 
@@ -613,15 +1194,12 @@ BEGIN
 		realworld.users
 	WHERE 
 		user_id = _user_id;
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.get_user_by_username(
 	_username CITEXT)
     RETURNS SETOF realworld.realworld_user 
 AS $$
-BEGIN
-	RETURN QUERY
 	SELECT 
 		user_id, 
 		username, 
@@ -633,80 +1211,160 @@ BEGIN
 		realworld.users
 	WHERE 
 		username = _username;
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.is_favorited_article(
 	_article_id INT,
 	_user_id INT = NULL)
     RETURNS BOOL
 AS $$
-BEGIN
-	RETURN EXISTS (
+	SELECT EXISTS (
 		SELECT 
 			1 
 		FROM 
 			realworld.favorites
 		WHERE user_id = _user_id AND article_id = _article_id
 	);
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
 
 CREATE OR REPLACE FUNCTION realworld.is_following(
 	_follower INT,
 	_followed INT)
     RETURNS BOOL
 AS $$
-BEGIN
-	RETURN EXISTS (
+	SELECT EXISTS (
 		SELECT 
 			1 
 		FROM 
 			realworld.followers
 		WHERE follower = _follower AND followed = _followed
 	);
-END;
-$$ LANGUAGE plpgsql;
+$$ LANGUAGE sql STABLE PARALLEL SAFE;
+
+-- Records the edge's state after a follow or unfollow, see
+-- realworld.follow_changes. changed_at is set once the row is locked.
+CREATE OR REPLACE FUNCTION realworld.log_follow_change(
+	_follower INT,
+	_followed INT,
+	_following BOOL)
+    RETURNS TIMESTAMPTZ
+AS $$
+	INSERT INTO
+		realworld.follow_changes(follower, followed, following, changed_at)
+	VALUES
+		(_follower, _followed, _following, clock_timestamp())
+	ON CONFLICT (follower, followed) DO UPDATE SET
+		following = EXCLUDED.following,
+		changed_at = clock_timestamp()
+	RETURNING
+		changed_at;
+$$ LANGUAGE sql;
+
+-- Followers above which an author's articles are no longer fanned out
+CREATE OR REPLACE FUNCTION realworld.timeline_max_fanout()
+    RETURNS INT
+AS $$
+	SELECT 10000;
+$$ LANGUAGE sql IMMUTABLE PARALLEL SAFE;
 
+-- No row when there is no such article
 CREATE OR REPLACE FUNCTION realworld.unfavorite_article(
 	_slug VARCHAR(255),
 	_user_id INT)
-    RETURNS VOID
+    RETURNS SETOF realworld.article_with_author_profile
 AS $$
+DECLARE
+	_article_id INT;
 BEGIN
+	SELECT article_id INTO _article_id FROM realworld.articles WHERE slug = _slug;
+	IF _article_id IS NULL THEN
+		RETURN;
+	END IF;
+
 	DELETE FROM
 		realworld.favorites
 	WHERE
 		user_id = _user_id AND 
-		article_id = (SELECT article_id FROM realworld.articles WHERE slug = _slug);
+		article_id = _article_id;
+
+	IF FOUND THEN
+		UPDATE
+			realworld.favorites_counters
+		SET
+			favorites_count = favorites_count - 1
+		WHERE
+			article_id = _article_id AND
+			shard = _user_id % 16;
+	END IF;
+
+	RETURN QUERY
+	SELECT * FROM realworld.get_article_with_author_profile(_article_id, _user_id);
 END;
 $$ LANGUAGE plpgsql;
 
+-- The same columns as follow, no row when there is no such user
 CREATE OR REPLACE FUNCTION realworld.unfollow(
 	_follower INT,
-	_followed INT)
-    RETURNS VOID
+	_username CITEXT)
+    RETURNS TABLE(user_id INT, changed_at TIMESTAMPTZ, profile realworld.profile)
 AS $$
+DECLARE
+	_followed INT;
+	_changed_at TIMESTAMPTZ;
 BEGIN
+	SELECT u.user_id INTO _followed FROM realworld.users AS u WHERE u.username = _username FOR SHARE;
+	IF _followed IS NULL THEN
+		RETURN;
+	END IF;
+	-- Locks the edge first, see follow
+	_changed_at := realworld.log_follow_change(_follower, _followed, FALSE);
+
 	DELETE FROM
 		realworld.followers
 	WHERE 
 		follower = _follower AND 
 		followed = _followed;
+
+	DELETE FROM
+		realworld.timelines AS t
+	WHERE
+		t.user_id = _follower AND
+		t.author_id = _followed;
+
+	RETURN QUERY
+	SELECT _followed, _changed_at, p FROM realworld.get_profile(_followed, _follower) AS p;
 END;
 $$ LANGUAGE plpgsql;
 
+-- The updated article when it is the author's, FALSE and no article when
+-- it belongs to another author and no row when there is no such article
 CREATE OR REPLACE FUNCTION realworld.update_article_by_slug(
 	_old_slug VARCHAR(255),
 	_author_id INT,
 	_title VARCHAR(255) = NULL,
 	_new_slug VARCHAR(255) = NULL,
 	_description TEXT = NULL,
-	_body TEXT = NULL)
-    RETURNS SETOF INT 
+	_body TEXT = NULL,
+	_tag_list VARCHAR(255)[] = NULL)
+    RETURNS TABLE(owned BOOL, article realworld.article_with_author_profile)
 AS $$
+DECLARE
+	_article_id INT;
+	_old_tag_list VARCHAR(255)[];
 BEGIN
-	RETURN QUERY
+	IF _tag_list IS NOT NULL THEN
+		SELECT
+			tag_list
+		INTO
+			_old_tag_list
+		FROM
+			realworld.articles
+		WHERE
+			slug = _old_slug AND
+			author_id = _author_id
+		FOR NO KEY UPDATE;
+	END IF;
+
 	UPDATE
 		realworld.articles
 	SET 
@@ -714,12 +1372,56 @@ BEGIN
 		slug = COALESCE(_new_slug, slug),
 		description = COALESCE(_description, description),
 		body = COALESCE(_body, body),
+		tag_list = CASE
+			WHEN _tag_list IS NULL THEN tag_list
+			ELSE ARRAY(SELECT DISTINCT t FROM unnest(_tag_list) AS t ORDER BY t)
+		END,
 		updated_at = NOW()
 	WHERE
 		slug = _old_slug AND
 		author_id = _author_id
 	RETURNING 
-		article_id;
+		article_id
+	INTO
+		_article_id;
+
+	IF _article_id IS NULL THEN
+		RETURN QUERY
+		SELECT FALSE, NULL::realworld.article_with_author_profile FROM realworld.articles WHERE slug = _old_slug;
+		RETURN;
+	END IF;
+
+	IF _tag_list IS NOT NULL THEN
+		INSERT INTO 
+			realworld.tags(name)
+		SELECT 
+			unnest(_tag_list)
+		ON CONFLICT DO NOTHING;
+
+		PERFORM realworld.count_tag_articles(_old_tag_list, _tag_list);
+
+		DELETE FROM
+			realworld.article_tags AS at
+		USING
+			realworld.tags AS t
+		WHERE
+			at.article_id = _article_id AND
+			t.tag_id = at.tag_id AND
+			t.name <> ALL (_tag_list);
+
+		INSERT INTO 
+			realworld.article_tags (article_id, tag_id)
+		SELECT 
+			_article_id, tag_id
+		FROM 
+			realworld.tags
+		WHERE 
+			name = ANY (_tag_list)
+		ON CONFLICT DO NOTHING;
+	END IF;
+
+	RETURN QUERY
+	SELECT TRUE, a FROM realworld.get_article_with_author_profile(_article_id, _author_id) AS a;
 END;
 $$ LANGUAGE plpgsql;
 
@@ -741,7 +1443,8 @@ BEGIN
 		email = COALESCE(_email, email),
 		password_hash = COALESCE(_password_hash, password_hash),
 		bio = COALESCE(_bio, bio),
-		image = COALESCE(_image, image)
+		image = COALESCE(_image, image),
+		updated_at = NOW()
 	WHERE
 		user_id = _user_id
 	RETURNING 
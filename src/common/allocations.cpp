@@ -0,0 +1,38 @@
+#include "allocations.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace realworld::allocations {
+
+namespace {
+
+thread_local Counters thread_counters;
+
+}  // namespace
+
+Counters GetThreadCounters() noexcept { return thread_counters; }
+
+Scope::Scope() noexcept : start_{GetThreadCounters()} {}
+
+Counters Scope::Get() const noexcept {
+  const auto now = GetThreadCounters();
+  return {now.count_ - start_.count_, now.bytes_ - start_.bytes_};
+}
+
+}  // namespace realworld::allocations
+
+// The other forms of new and delete of the standard library go through
+// these two
+void* operator new(std::size_t size) {
+  auto& counters = realworld::allocations::thread_counters;
+  ++counters.count_;
+  counters.bytes_ += size;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace realworld::allocations {
+
+// Heap allocations made through operator new by the current thread since
+// it started. The service replaces the global operator new to count them.
+struct Counters final {
+  std::uint64_t count_{0};
+  std::uint64_t bytes_{0};
+};
+
+Counters GetThreadCounters() noexcept;
+
+// Allocations of the current thread between construction and Get(). Only
+// meaningful around code that does not suspend, a task may be resumed on
+// another thread.
+class Scope final {
+ public:
+  Scope() noexcept;
+
+  Counters Get() const noexcept;
+
+ private:
+  const Counters start_;
+};
+
+}  // namespace realworld::allocations
@@ -0,0 +1,20 @@
+#include "allocations.hpp"
+#include <new>
+#include <userver/utest/utest.hpp>
+
+namespace realworld {
+
+UTEST(Allocations, Scope) {
+  const allocations::Scope scope;
+  EXPECT_EQ(scope.Get().count_, 0);
+  // Called directly, new expressions may be optimized out
+  void* first = ::operator new(16);
+  void* second = ::operator new(100);
+  const auto counters = scope.Get();
+  ::operator delete(second);
+  ::operator delete(first);
+  EXPECT_EQ(counters.count_, 2);
+  EXPECT_EQ(counters.bytes_, 116);
+}
+
+}  // namespace realworld
@@ -0,0 +1,95 @@
+#include "article_cache.hpp"
+#include <utility>
+
+namespace realworld::articles {
+
+ArticleCache::ArticleCache(std::size_t ways, std::size_t way_size,
+                           std::chrono::milliseconds max_age)
+    : max_age_{max_age},
+      cache_{ways, way_size},
+      tombstones_{ways, way_size} {}
+
+ArticleCache::ArticlePtr ArticleCache::Get(std::string_view slug) const {
+  const std::string key{slug};
+  const auto entry = cache_.Get(key);
+  if (!entry) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  const auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - entry->cached_at_);
+  if (age >= max_age_) {
+    cache_.InvalidateByKey(key);
+    expired_.fetch_add(1, std::memory_order_relaxed);
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  hit_age_sum_ms_.fetch_add(age.count(), std::memory_order_relaxed);
+  return entry->article_;
+}
+
+void ArticleCache::Put(const models::ArticleWithAuthorProfile& article) const {
+  if (IsRecentlyWritten(article.slug_)) {
+    rejected_puts_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto copy = std::make_shared<models::ArticleWithAuthorProfile>(article);
+  copy->favorited_ = false;
+  copy->author_.following_ = false;
+  cache_.Put(article.slug_,
+             Entry{std::move(copy), std::chrono::steady_clock::now()});
+  // Invalidate leaves the tombstone before dropping the entry, so a write
+  // that raced the check above is seen here or drops the entry itself
+  if (IsRecentlyWritten(article.slug_)) {
+    cache_.InvalidateByKey(article.slug_);
+    rejected_puts_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool ArticleCache::IsRecentlyWritten(std::string_view slug) const {
+  const auto written_at = tombstones_.Get(std::string{slug});
+  return written_at &&
+         std::chrono::steady_clock::now() - *written_at < max_age_;
+}
+
+void ArticleCache::Invalidate(std::string_view slug) const {
+  std::string key{slug};
+  tombstones_.Put(key, std::chrono::steady_clock::now());
+  cache_.InvalidateByKey(key);
+  invalidations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ArticleCache::InvalidateAll() const {
+  tombstones_.Invalidate();
+  cache_.Invalidate();
+}
+
+std::size_t ArticleCache::GetSize() const { return cache_.GetSize(); }
+
+std::uint64_t ArticleCache::GetHits() const noexcept {
+  return hits_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ArticleCache::GetMisses() const noexcept {
+  return misses_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ArticleCache::GetExpired() const noexcept {
+  return expired_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ArticleCache::GetInvalidations() const noexcept {
+  return invalidations_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ArticleCache::GetRejectedPuts() const noexcept {
+  return rejected_puts_.load(std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds ArticleCache::GetHitAgeSum() const noexcept {
+  return std::chrono::milliseconds{
+      hit_age_sum_ms_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace realworld::articles
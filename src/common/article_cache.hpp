@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "models/article.hpp"
+#include "userver/cache/nway_lru_cache.hpp"
+
+namespace realworld::articles {
+
+// Bounded cache of articles by slug without the viewer columns: favorited
+// and author.following are false in every cached article. Entries are
+// dropped by this process on writes to the article and returned for at most
+// max_age after they were read, which bounds how stale writes made by other
+// processes, and changes of the author profile, can be seen.
+//
+// A write also leaves a tombstone that keeps the slug out of the cache for
+// max_age: a read that overlapped the write, or that a replica behind the
+// write answered, would otherwise cache the old article again.
+class ArticleCache final {
+ public:
+  using ArticlePtr = std::shared_ptr<const models::ArticleWithAuthorProfile>;
+
+  ArticleCache(std::size_t ways, std::size_t way_size,
+               std::chrono::milliseconds max_age);
+
+  // nullptr if there is no entry or it is older than max_age
+  ArticlePtr Get(std::string_view slug) const;
+
+  // Caches a copy of the article under its slug with the viewer columns
+  // cleared, replacing the entry of that slug. Does nothing while the slug
+  // has a tombstone.
+  void Put(const models::ArticleWithAuthorProfile& article) const;
+
+  // Whether the slug has a tombstone, i.e. was written by this process less
+  // than max_age ago: read it from the master then
+  bool IsRecentlyWritten(std::string_view slug) const;
+
+  // Drops the entry and leaves a tombstone
+  void Invalidate(std::string_view slug) const;
+  // Drops the entries and the tombstones
+  void InvalidateAll() const;
+
+  std::size_t GetSize() const;
+  std::uint64_t GetHits() const noexcept;
+  std::uint64_t GetMisses() const noexcept;
+  // Misses on entries older than max_age, counted in GetMisses() too
+  std::uint64_t GetExpired() const noexcept;
+  std::uint64_t GetInvalidations() const noexcept;
+  // Puts skipped because of a tombstone
+  std::uint64_t GetRejectedPuts() const noexcept;
+  // Sum over all hits of the age of the returned entry
+  std::chrono::milliseconds GetHitAgeSum() const noexcept;
+
+ private:
+  struct Entry final {
+    ArticlePtr article_;
+    std::chrono::steady_clock::time_point cached_at_;
+  };
+
+  const std::chrono::milliseconds max_age_;
+  mutable userver::cache::NWayLRU<std::string, Entry> cache_;
+  // Slugs by the time of their last write
+  mutable userver::cache::NWayLRU<std::string,
+                                  std::chrono::steady_clock::time_point>
+      tombstones_;
+  mutable std::atomic<std::uint64_t> hits_{0};
+  mutable std::atomic<std::uint64_t> misses_{0};
+  mutable std::atomic<std::uint64_t> expired_{0};
+  mutable std::atomic<std::uint64_t> invalidations_{0};
+  mutable std::atomic<std::uint64_t> rejected_puts_{0};
+  mutable std::atomic<std::int64_t> hit_age_sum_ms_{0};
+};
+
+}  // namespace realworld::articles
@@ -0,0 +1,90 @@
+#include "article_cache.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <userver/engine/run_standalone.hpp>
+
+namespace realworld {
+
+namespace {
+
+constexpr std::size_t kArticles{200000};
+
+// Slug indexes drawn from a Zipf distribution with exponent 1: the article
+// of rank k is read in proportion to 1 / k
+std::vector<std::size_t> MakeZipfWorkload(std::size_t size) {
+  std::vector<double> cdf(kArticles);
+  double sum{0};
+  for (std::size_t k = 0; k < kArticles; ++k) {
+    sum += 1.0 / static_cast<double>(k + 1);
+    cdf[k] = sum;
+  }
+  std::mt19937_64 random{42};
+  std::uniform_real_distribution<double> uniform{0, sum};
+  std::vector<std::size_t> workload(size);
+  for (auto& index : workload) {
+    index = std::lower_bound(cdf.begin(), cdf.end(), uniform(random)) -
+            cdf.begin();
+  }
+  return workload;
+}
+
+models::ArticleWithAuthorProfile MakeArticle(std::size_t index) {
+  models::ArticleWithAuthorProfile article{};
+  article.article_id_ = static_cast<int>(index);
+  article.title_ = "Article " + std::to_string(index);
+  article.slug_ = "article-" + std::to_string(index);
+  article.description_ = "Description of article " + std::to_string(index);
+  article.body_ = std::string(1000, 'x');
+  article.tag_list_ = std::vector<std::string>{"dragons", "training"};
+  article.author_.username_ = "jake";
+  return article;
+}
+
+}  // namespace
+
+// The GET /api/articles/:slug path through the cache on a Zipf workload
+// over 200k articles, a miss puts the article the way the handler does
+// after reading it from the database. range(0) is the cache capacity; the
+// hit ratio counter is the share of requests that skip the article query.
+void ArticleCacheZipfBenchmark(benchmark::State& state) {
+  userver::engine::RunStandalone([&] {
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+    const articles::ArticleCache cache{16, capacity / 16,
+                                       std::chrono::minutes{1}};
+    const auto workload = MakeZipfWorkload(1 << 20);
+    std::vector<std::string> slugs(kArticles);
+    for (std::size_t i = 0; i < kArticles; ++i) {
+      slugs[i] = "article-" + std::to_string(i);
+    }
+    // Warm up so that the counters show the steady state
+    for (const auto index : workload) {
+      if (!cache.Get(slugs[index])) {
+        cache.Put(MakeArticle(index));
+      }
+    }
+    const auto hits = cache.GetHits();
+    const auto misses = cache.GetMisses();
+
+    std::size_t i{0};
+    for (auto _ : state) {
+      const auto index = workload[i++ % workload.size()];
+      auto article = cache.Get(slugs[index]);
+      if (!article) {
+        cache.Put(MakeArticle(index));
+      }
+      benchmark::DoNotOptimize(article);
+    }
+    const auto run_hits = cache.GetHits() - hits;
+    const auto run_misses = cache.GetMisses() - misses;
+    state.counters["hit_ratio"] = static_cast<double>(run_hits) /
+                                  static_cast<double>(run_hits + run_misses);
+  });
+}
+BENCHMARK(ArticleCacheZipfBenchmark)->RangeMultiplier(4)->Range(1 << 10,
+                                                                1 << 16);
+
+}  // namespace realworld
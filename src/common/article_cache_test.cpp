@@ -0,0 +1,114 @@
+#include "article_cache.hpp"
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+namespace realworld {
+
+namespace {
+
+models::ArticleWithAuthorProfile MakeArticle(const std::string& slug) {
+  models::ArticleWithAuthorProfile article{};
+  article.article_id_ = 1;
+  article.title_ = "Title";
+  article.slug_ = slug;
+  article.description_ = "Description";
+  article.body_ = "Body";
+  article.tag_list_ = std::vector<std::string>{"dragons"};
+  article.favorited_ = true;
+  article.favorites_count_ = 3;
+  article.author_.username_ = "jake";
+  article.author_.following_ = true;
+  return article;
+}
+
+}  // namespace
+
+UTEST(ArticleCache, GetClearsViewerColumns) {
+  const articles::ArticleCache cache{1, 16, std::chrono::minutes{1}};
+  EXPECT_EQ(cache.Get("slug"), nullptr);
+  cache.Put(MakeArticle("slug"));
+
+  const auto article = cache.Get("slug");
+  ASSERT_NE(article, nullptr);
+  EXPECT_EQ(article->slug_, "slug");
+  EXPECT_EQ(article->favorites_count_, 3);
+  EXPECT_EQ(article->author_.username_, "jake");
+  EXPECT_FALSE(article->favorited_);
+  EXPECT_FALSE(article->author_.following_);
+  EXPECT_EQ(cache.Get("other"), nullptr);
+
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_EQ(cache.GetHits(), 1);
+  EXPECT_EQ(cache.GetMisses(), 2);
+}
+
+UTEST(ArticleCache, PutReplaces) {
+  const articles::ArticleCache cache{1, 16, std::chrono::minutes{1}};
+  auto article = MakeArticle("slug");
+  cache.Put(article);
+  const auto old_article = cache.Get("slug");
+  article.favorites_count_ = 4;
+  cache.Put(article);
+
+  EXPECT_EQ(cache.Get("slug")->favorites_count_, 4);
+  // Readers keep the entry they got
+  EXPECT_EQ(old_article->favorites_count_, 3);
+}
+
+UTEST(ArticleCache, Invalidate) {
+  const articles::ArticleCache cache{1, 16, std::chrono::minutes{1}};
+  cache.Put(MakeArticle("first"));
+  cache.Put(MakeArticle("second"));
+  cache.Invalidate("first");
+  EXPECT_EQ(cache.Get("first"), nullptr);
+  EXPECT_NE(cache.Get("second"), nullptr);
+  EXPECT_EQ(cache.GetInvalidations(), 1);
+
+  cache.InvalidateAll();
+  EXPECT_EQ(cache.Get("second"), nullptr);
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+UTEST(ArticleCache, TombstoneRejectsPuts) {
+  const articles::ArticleCache cache{1, 16, std::chrono::milliseconds{20}};
+  EXPECT_FALSE(cache.IsRecentlyWritten("slug"));
+  cache.Invalidate("slug");
+  EXPECT_TRUE(cache.IsRecentlyWritten("slug"));
+
+  // A read that overlapped the write
+  cache.Put(MakeArticle("slug"));
+  EXPECT_EQ(cache.Get("slug"), nullptr);
+  EXPECT_EQ(cache.GetRejectedPuts(), 1);
+
+  userver::engine::SleepFor(std::chrono::milliseconds{30});
+  EXPECT_FALSE(cache.IsRecentlyWritten("slug"));
+  cache.Put(MakeArticle("slug"));
+  EXPECT_NE(cache.Get("slug"), nullptr);
+
+  cache.Invalidate("slug");
+  cache.InvalidateAll();
+  EXPECT_FALSE(cache.IsRecentlyWritten("slug"));
+}
+
+UTEST(ArticleCache, Expires) {
+  const articles::ArticleCache cache{1, 16, std::chrono::milliseconds{20}};
+  cache.Put(MakeArticle("slug"));
+  EXPECT_NE(cache.Get("slug"), nullptr);
+
+  userver::engine::SleepFor(std::chrono::milliseconds{30});
+  EXPECT_EQ(cache.Get("slug"), nullptr);
+  EXPECT_EQ(cache.GetExpired(), 1);
+  EXPECT_EQ(cache.GetMisses(), 1);
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+UTEST(ArticleCache, Bounded) {
+  const articles::ArticleCache cache{1, 2, std::chrono::minutes{1}};
+  cache.Put(MakeArticle("first"));
+  cache.Put(MakeArticle("second"));
+  cache.Put(MakeArticle("third"));
+  EXPECT_EQ(cache.GetSize(), 2);
+  EXPECT_EQ(cache.Get("first"), nullptr);
+}
+
+}  // namespace realworld
@@ -1,12 +1,35 @@
 #pragma once
 
-#include <common/jwt.hpp>
+#include <cstdint>
+#include <string_view>
+#include "userver/server/request/request_context.hpp"
 
 namespace realworld::auth {
 
+// Set by AuthChecker once per authorized request. The token points into the
+// Authorization header, so it is valid until the request is destroyed.
 struct UserAuthData final {
   std::int32_t id_{};
-  jwt::DecodedToken token_;
+  std::string_view token_;
 };
 
-}  // namespace realworld::auth
\ No newline at end of file
+// The auth data lives in the typed user data slot of the request context, so
+// reading it neither hashes a string key nor copies the token.
+inline void SetUserAuthData(
+    userver::server::request::RequestContext& request_context,
+    UserAuthData user_auth_data) {
+  request_context.SetUserData(user_auth_data);
+}
+
+inline const UserAuthData& GetUserAuthData(
+    const userver::server::request::RequestContext& request_context) {
+  return request_context.GetUserData<UserAuthData>();
+}
+
+// Returns nullptr if the request is not authorized, for optional auth
+inline const UserAuthData* GetUserAuthDataOptional(
+    const userver::server::request::RequestContext& request_context) {
+  return request_context.GetUserDataOptional<UserAuthData>();
+}
+
+}  // namespace realworld::auth
@@ -0,0 +1,74 @@
+#include "base64.hpp"
+#include <array>
+#include <cstdint>
+
+namespace realworld::base64 {
+
+namespace {
+
+constexpr std::string_view kBase64UrlAlphabet{
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"};
+
+constexpr std::array<std::int8_t, 256> MakeBase64UrlDecodeTable() {
+  std::array<std::int8_t, 256> table{};
+  for (auto& value : table) {
+    value = -1;
+  }
+  for (std::size_t i = 0; i < kBase64UrlAlphabet.size(); ++i) {
+    table[static_cast<unsigned char>(kBase64UrlAlphabet[i])] =
+        static_cast<std::int8_t>(i);
+  }
+  return table;
+}
+
+constexpr auto kBase64UrlDecodeTable = MakeBase64UrlDecodeTable();
+
+}  // namespace
+
+void AppendUrl(std::string& out, std::string_view data) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  std::size_t i{0};
+  for (; i + 3 <= data.size(); i += 3) {
+    const auto triple = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+    out += kBase64UrlAlphabet[(triple >> 18) & 0x3F];
+    out += kBase64UrlAlphabet[(triple >> 12) & 0x3F];
+    out += kBase64UrlAlphabet[(triple >> 6) & 0x3F];
+    out += kBase64UrlAlphabet[triple & 0x3F];
+  }
+  const auto left = data.size() - i;
+  if (left == 1) {
+    const auto triple = bytes[i] << 16;
+    out += kBase64UrlAlphabet[(triple >> 18) & 0x3F];
+    out += kBase64UrlAlphabet[(triple >> 12) & 0x3F];
+  } else if (left == 2) {
+    const auto triple = (bytes[i] << 16) | (bytes[i + 1] << 8);
+    out += kBase64UrlAlphabet[(triple >> 18) & 0x3F];
+    out += kBase64UrlAlphabet[(triple >> 12) & 0x3F];
+    out += kBase64UrlAlphabet[(triple >> 6) & 0x3F];
+  }
+}
+
+std::optional<std::string> DecodeUrl(std::string_view data) {
+  if (data.size() % 4 == 1) {
+    return std::nullopt;
+  }
+  std::string out;
+  out.reserve(data.size() / 4 * 3 + 2);
+  std::uint32_t bits{0};
+  int bit_count{0};
+  for (const auto c : data) {
+    const auto value = kBase64UrlDecodeTable[static_cast<unsigned char>(c)];
+    if (value < 0) {
+      return std::nullopt;
+    }
+    bits = (bits << 6) | static_cast<std::uint32_t>(value);
+    bit_count += 6;
+    if (bit_count >= 8) {
+      bit_count -= 8;
+      out += static_cast<char>((bits >> bit_count) & 0xFF);
+    }
+  }
+  return out;
+}
+
+}  // namespace realworld::base64
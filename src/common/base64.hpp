@@ -0,0 +1,15 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace realworld::base64 {
+
+// Unpadded base64url, as required by RFC 7515
+void AppendUrl(std::string& out, std::string_view data);
+
+// Returns std::nullopt if data is not unpadded base64url
+std::optional<std::string> DecodeUrl(std::string_view data);
+
+}  // namespace realworld::base64
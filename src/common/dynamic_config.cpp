@@ -0,0 +1,10 @@
+#include "dynamic_config.hpp"
+
+namespace realworld::dynamic_config {
+
+bool ParseConcurrentQueriesEnabled(
+    const userver::dynamic_config::DocsMap& docs_map) {
+  return docs_map.Get("REALWORLD_CONCURRENT_QUERIES_ENABLED").As<bool>();
+}
+
+}  // namespace realworld::dynamic_config
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "userver/dynamic_config/snapshot.hpp"
+#include "userver/dynamic_config/value.hpp"
+
+namespace realworld::dynamic_config {
+
+// REALWORLD_CONCURRENT_QUERIES_ENABLED: handlers run their independent
+// queries as concurrent tasks, each on a connection of its own. Turned off
+// they run one after another on a single connection at a time.
+bool ParseConcurrentQueriesEnabled(
+    const userver::dynamic_config::DocsMap& docs_map);
+
+inline constexpr userver::dynamic_config::Key<ParseConcurrentQueriesEnabled>
+    kConcurrentQueriesEnabled;
+
+}  // namespace realworld::dynamic_config
@@ -30,6 +30,13 @@ class ValidationError
   userver::formats::json::Value ToJson() const;
 };
 
+class MalformedRequestError
+    : public userver::server::handlers::ExceptionWithCode<
+          userver::server::handlers::HandlerErrorCode::kRequestParseError> {
+ public:
+  using BaseType::BaseType;
+};
+
 class ForbiddenError
     : public userver::server::handlers::ExceptionWithCode<
           userver::server::handlers::HandlerErrorCode::kForbidden> {
@@ -37,4 +44,11 @@ class ForbiddenError
   using BaseType::BaseType;
 };
 
+class ServiceUnavailableError
+    : public userver::server::handlers::ExceptionWithCode<
+          userver::server::handlers::HandlerErrorCode::kServiceUnavailable> {
+ public:
+  using BaseType::BaseType;
+};
+
 }  // namespace realworld::errors
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include "follow_graph.hpp"
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+namespace realworld::follows {
+
+namespace {
+
+// Below this many authors an array is small enough whatever the ids are
+constexpr std::size_t kMinBitmapSize{4096};
+
+std::size_t GetIndex(std::int32_t id) noexcept {
+  return static_cast<std::uint32_t>(id);
+}
+
+}  // namespace
+
+bool FollowSet::Contains(std::int32_t followed) const noexcept {
+  if (bitmap_) {
+    const auto bit = GetIndex(followed);
+    return bit / 64 < bitmap_->words_.size() &&
+           (bitmap_->words_[bit / 64] >> (bit % 64) & 1);
+  }
+  return std::binary_search(sorted_.begin(), sorted_.end(), followed);
+}
+
+bool FollowSet::Insert(std::int32_t followed) {
+  if (bitmap_) {
+    const auto bit = GetIndex(followed);
+    if (bit / 64 >= bitmap_->words_.size()) {
+      bitmap_->words_.resize(bit / 64 + 1);
+    }
+    auto& word = bitmap_->words_[bit / 64];
+    const auto mask = std::uint64_t{1} << (bit % 64);
+    if (word & mask) {
+      return false;
+    }
+    word |= mask;
+    ++bitmap_->size_;
+    return true;
+  }
+  const auto it = std::lower_bound(sorted_.begin(), sorted_.end(), followed);
+  if (it != sorted_.end() && *it == followed) {
+    return false;
+  }
+  sorted_.insert(it, followed);
+  ConvertIfDense();
+  return true;
+}
+
+bool FollowSet::Erase(std::int32_t followed) {
+  if (bitmap_) {
+    const auto bit = GetIndex(followed);
+    if (bit / 64 >= bitmap_->words_.size()) {
+      return false;
+    }
+    auto& word = bitmap_->words_[bit / 64];
+    const auto mask = std::uint64_t{1} << (bit % 64);
+    if (!(word & mask)) {
+      return false;
+    }
+    word &= ~mask;
+    --bitmap_->size_;
+    return true;
+  }
+  const auto it = std::lower_bound(sorted_.begin(), sorted_.end(), followed);
+  if (it == sorted_.end() || *it != followed) {
+    return false;
+  }
+  sorted_.erase(it);
+  return true;
+}
+
+std::size_t FollowSet::size() const noexcept {
+  return bitmap_ ? bitmap_->size_ : sorted_.size();
+}
+
+bool FollowSet::IsBitmap() const noexcept { return bitmap_ != nullptr; }
+
+std::size_t FollowSet::GetBytes() const noexcept {
+  if (bitmap_) {
+    return sizeof(Bitmap) +
+           bitmap_->words_.capacity() * sizeof(std::uint64_t);
+  }
+  return sorted_.capacity() * sizeof(std::int32_t);
+}
+
+void FollowSet::ShrinkToFit() {
+  if (bitmap_) {
+    bitmap_->words_.shrink_to_fit();
+  } else {
+    sorted_.shrink_to_fit();
+  }
+}
+
+void FollowSet::ConvertIfDense() {
+  if (sorted_.size() < kMinBitmapSize) {
+    return;
+  }
+  const auto words = GetIndex(sorted_.back()) / 64 + 1;
+  if (sorted_.size() * sizeof(std::int32_t) <=
+      words * sizeof(std::uint64_t)) {
+    return;
+  }
+  auto bitmap = std::make_unique<Bitmap>();
+  bitmap->words_.resize(words);
+  for (const auto followed : sorted_) {
+    const auto bit = GetIndex(followed);
+    bitmap->words_[bit / 64] |= std::uint64_t{1} << (bit % 64);
+  }
+  bitmap->size_ = sorted_.size();
+  bitmap_ = std::move(bitmap);
+  sorted_ = {};
+}
+
+bool FollowGraph::IsFollowing(std::int32_t follower,
+                              std::int32_t followed) const {
+  const auto& shard = GetShard(follower);
+  const auto index = GetIndex(follower) / kShards;
+  std::shared_lock lock{shard.mutex_};
+  return index < shard.followers_.size() &&
+         shard.followers_[index].Contains(followed);
+}
+
+std::vector<bool> FollowGraph::AreFollowed(
+    std::int32_t follower, const std::vector<std::int32_t>& authors) const {
+  std::vector<bool> followed(authors.size());
+  const auto& shard = GetShard(follower);
+  const auto index = GetIndex(follower) / kShards;
+  std::shared_lock lock{shard.mutex_};
+  if (index >= shard.followers_.size()) {
+    return followed;
+  }
+  const auto& follow_set = shard.followers_[index];
+  for (std::size_t i = 0; i < authors.size(); ++i) {
+    followed[i] = follow_set.Contains(authors[i]);
+  }
+  return followed;
+}
+
+bool FollowGraph::Follow(std::int32_t follower, std::int32_t followed) {
+  auto& shard = GetShard(follower);
+  const auto index = GetIndex(follower) / kShards;
+  std::unique_lock lock{shard.mutex_};
+  if (index >= shard.followers_.size()) {
+    shard.followers_.resize(index + 1);
+  }
+  if (!shard.followers_[index].Insert(followed)) {
+    return false;
+  }
+  edges_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool FollowGraph::Unfollow(std::int32_t follower, std::int32_t followed) {
+  auto& shard = GetShard(follower);
+  const auto index = GetIndex(follower) / kShards;
+  std::unique_lock lock{shard.mutex_};
+  if (index >= shard.followers_.size() ||
+      !shard.followers_[index].Erase(followed)) {
+    return false;
+  }
+  edges_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+void FollowGraph::Add(const std::vector<Edge>& edges) {
+  std::size_t added{0};
+  for (auto it = edges.begin(); it != edges.end();) {
+    // One lock for all the edges of a follower
+    const auto follower = it->follower_;
+    auto& shard = GetShard(follower);
+    const auto index = GetIndex(follower) / kShards;
+    std::unique_lock lock{shard.mutex_};
+    if (index >= shard.followers_.size()) {
+      shard.followers_.resize(index + 1);
+    }
+    auto& follow_set = shard.followers_[index];
+    for (; it != edges.end() && it->follower_ == follower; ++it) {
+      added += follow_set.Insert(it->followed_);
+    }
+  }
+  edges_.fetch_add(added, std::memory_order_relaxed);
+}
+
+void FollowGraph::ShrinkToFit() {
+  for (auto& shard : shards_) {
+    std::unique_lock lock{shard.mutex_};
+    shard.followers_.shrink_to_fit();
+    for (auto& follow_set : shard.followers_) {
+      follow_set.ShrinkToFit();
+    }
+  }
+}
+
+std::size_t FollowGraph::GetEdges() const noexcept {
+  return edges_.load(std::memory_order_relaxed);
+}
+
+FollowGraph::Memory FollowGraph::GetMemory() const {
+  Memory memory;
+  for (const auto& shard : shards_) {
+    std::shared_lock lock{shard.mutex_};
+    memory.bytes_ += shard.followers_.capacity() * sizeof(FollowSet);
+    for (const auto& follow_set : shard.followers_) {
+      memory.bytes_ += follow_set.GetBytes();
+      memory.followers_ += follow_set.size() != 0;
+      memory.bitmap_followers_ += follow_set.IsBitmap();
+    }
+  }
+  return memory;
+}
+
+FollowGraph::Shard& FollowGraph::GetShard(std::int32_t follower) noexcept {
+  return shards_[GetIndex(follower) % kShards];
+}
+
+const FollowGraph::Shard& FollowGraph::GetShard(
+    std::int32_t follower) const noexcept {
+  return shards_[GetIndex(follower) % kShards];
+}
+
+}  // namespace realworld::follows
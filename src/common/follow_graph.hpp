@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "userver/engine/shared_mutex.hpp"
+
+namespace realworld::follows {
+
+// Authors one user follows: a sorted array, turned into a bitmap over
+// author ids once the array would take more memory than the bitmap, which
+// only happens for users following a large share of all authors
+class FollowSet final {
+ public:
+  bool Contains(std::int32_t followed) const noexcept;
+
+  // false if already followed
+  bool Insert(std::int32_t followed);
+  // false if not followed
+  bool Erase(std::int32_t followed);
+
+  std::size_t size() const noexcept;
+  bool IsBitmap() const noexcept;
+  // Heap bytes of the array or the bitmap
+  std::size_t GetBytes() const noexcept;
+
+  void ShrinkToFit();
+
+ private:
+  struct Bitmap final {
+    std::vector<std::uint64_t> words_;
+    std::size_t size_{0};
+  };
+
+  void ConvertIfDense();
+
+  std::vector<std::int32_t> sorted_;
+  std::unique_ptr<Bitmap> bitmap_;
+};
+
+// Who follows whom, by follower. Followers are split into shards by id,
+// each a vector indexed by id under its own reader-writer lock, so lookups
+// of different viewers and the rare follow writes do not contend.
+class FollowGraph final {
+ public:
+  struct Edge final {
+    std::int32_t follower_;
+    std::int32_t followed_;
+  };
+
+  bool IsFollowing(std::int32_t follower, std::int32_t followed) const;
+
+  // Which of the authors the follower follows, in their order, under one
+  // lock
+  std::vector<bool> AreFollowed(
+      std::int32_t follower, const std::vector<std::int32_t>& authors) const;
+
+  // false if the edge was already there, or was not there for Unfollow
+  bool Follow(std::int32_t follower, std::int32_t followed);
+  bool Unfollow(std::int32_t follower, std::int32_t followed);
+
+  // For loading, edges are expected in the (follower, followed) order of
+  // the followers primary key, which appends to the arrays
+  void Add(const std::vector<Edge>& edges);
+  // Releases the spare capacity left by loading
+  void ShrinkToFit();
+
+  std::size_t GetEdges() const noexcept;
+
+  struct Memory final {
+    std::size_t followers_{0};
+    std::size_t bitmap_followers_{0};
+    std::size_t bytes_{0};
+  };
+  // Walks every shard, for statistics
+  Memory GetMemory() const;
+
+ private:
+  static constexpr std::size_t kShards{256};
+
+  struct Shard final {
+    mutable userver::engine::SharedMutex mutex_;
+    // By follower id / kShards
+    std::vector<FollowSet> followers_;
+  };
+
+  Shard& GetShard(std::int32_t follower) noexcept;
+  const Shard& GetShard(std::int32_t follower) const noexcept;
+
+  std::array<Shard, kShards> shards_;
+  std::atomic<std::size_t> edges_{0};
+};
+
+}  // namespace realworld::follows
@@ -0,0 +1,122 @@
+#include "follow_graph.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <userver/engine/run_standalone.hpp>
+
+namespace realworld {
+
+namespace {
+
+constexpr std::int32_t kUsers{1000000};
+// Every user follows kFollows authors, kHeavyFollowers users follow
+// kHeavyFollows each: 10M edges in all
+constexpr std::int32_t kFollows{9};
+constexpr std::int32_t kHeavyFollowers{2};
+constexpr std::int32_t kHeavyFollows{500000};
+
+// Edges in the order of the followers primary key. Authors are drawn with a
+// skew towards low ids, so that some are followed by many.
+std::vector<follows::FollowGraph::Edge> MakeEdges() {
+  std::mt19937 random{42};
+  std::uniform_real_distribution<double> uniform{0, 1};
+  std::vector<follows::FollowGraph::Edge> edges;
+  edges.reserve(std::size_t{kUsers} * kFollows +
+                std::size_t{kHeavyFollowers} * kHeavyFollows);
+  std::vector<std::int32_t> followed;
+  for (std::int32_t follower = 1; follower <= kUsers; ++follower) {
+    followed.clear();
+    const auto count = follower <= kHeavyFollowers ? kHeavyFollows : kFollows;
+    while (followed.size() < static_cast<std::size_t>(count)) {
+      const auto u = uniform(random);
+      followed.push_back(1 + static_cast<std::int32_t>(u * u * (kUsers - 1)));
+      if (followed.size() == static_cast<std::size_t>(count)) {
+        std::sort(followed.begin(), followed.end());
+        followed.erase(std::unique(followed.begin(), followed.end()),
+                       followed.end());
+      }
+    }
+    for (const auto id : followed) {
+      edges.push_back({follower, id});
+    }
+  }
+  return edges;
+}
+
+const follows::FollowGraph& GetGraph() {
+  static const auto graph = [] {
+    auto graph = std::make_unique<follows::FollowGraph>();
+    graph->Add(MakeEdges());
+    graph->ShrinkToFit();
+    return graph;
+  }();
+  return *graph;
+}
+
+}  // namespace
+
+// Loading 10M edges the way the component does at startup. bytes_per_edge
+// is the memory the graph accounts for.
+void FollowGraphLoadBenchmark(benchmark::State& state) {
+  userver::engine::RunStandalone([&] {
+    const auto edges = MakeEdges();
+    follows::FollowGraph::Memory memory;
+    for (auto _ : state) {
+      auto graph = std::make_unique<follows::FollowGraph>();
+      graph->Add(edges);
+      graph->ShrinkToFit();
+      memory = graph->GetMemory();
+    }
+    state.counters["edges"] = static_cast<double>(edges.size());
+    state.counters["bytes_per_edge"] =
+        static_cast<double>(memory.bytes_) / static_cast<double>(edges.size());
+    state.counters["bitmap_followers"] =
+        static_cast<double>(memory.bitmap_followers_);
+  });
+}
+BENCHMARK(FollowGraphLoadBenchmark)->Unit(benchmark::kMillisecond);
+
+void FollowGraphIsFollowingBenchmark(benchmark::State& state) {
+  userver::engine::RunStandalone([&] {
+    const auto& graph = GetGraph();
+    std::int32_t id{0};
+    for (auto _ : state) {
+      id = id % kUsers + 7919;
+      benchmark::DoNotOptimize(
+          graph.IsFollowing(id % kUsers + 1, id % 1000 + 1));
+    }
+  });
+}
+BENCHMARK(FollowGraphIsFollowingBenchmark);
+
+// A page of range(0) authors for one viewer, as in an article list. The
+// heavy followers, whose follows are bitmaps, are benchmarked separately.
+void FollowGraphAreFollowedBenchmark(benchmark::State& state) {
+  userver::engine::RunStandalone([&] {
+    const auto& graph = GetGraph();
+    std::mt19937 random{42};
+    std::uniform_int_distribution<std::int32_t> user{1, kUsers};
+    std::vector<std::vector<std::int32_t>> pages(1024);
+    for (auto& page : pages) {
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        page.push_back(user(random));
+      }
+    }
+    const bool heavy = state.range(1) != 0;
+    std::size_t i{0};
+    for (auto _ : state) {
+      const auto viewer =
+          heavy ? 1 + static_cast<std::int32_t>(i % kHeavyFollowers)
+                : user(random);
+      benchmark::DoNotOptimize(
+          graph.AreFollowed(viewer, pages[i++ % pages.size()]));
+    }
+  });
+}
+BENCHMARK(FollowGraphAreFollowedBenchmark)
+    ->Args({20, 0})
+    ->Args({20, 1})
+    ->Args({100, 0});
+
+}  // namespace realworld
@@ -0,0 +1,74 @@
+#include "follow_graph.hpp"
+#include <userver/utest/utest.hpp>
+
+namespace realworld {
+
+UTEST(FollowGraph, FollowAndUnfollow) {
+  follows::FollowGraph graph;
+  EXPECT_FALSE(graph.IsFollowing(1, 2));
+  EXPECT_TRUE(graph.Follow(1, 2));
+  EXPECT_FALSE(graph.Follow(1, 2));
+  EXPECT_TRUE(graph.Follow(1, 3));
+  // Same shard, another follower
+  EXPECT_TRUE(graph.Follow(257, 2));
+
+  EXPECT_TRUE(graph.IsFollowing(1, 2));
+  EXPECT_FALSE(graph.IsFollowing(2, 1));
+  EXPECT_EQ(graph.GetEdges(), 3);
+  EXPECT_EQ(graph.AreFollowed(1, {3, 4, 2}),
+            (std::vector<bool>{true, false, true}));
+  EXPECT_EQ(graph.AreFollowed(1000, {2}), std::vector<bool>{false});
+
+  EXPECT_TRUE(graph.Unfollow(1, 2));
+  EXPECT_FALSE(graph.Unfollow(1, 2));
+  EXPECT_FALSE(graph.Unfollow(1000, 2));
+  EXPECT_FALSE(graph.IsFollowing(1, 2));
+  EXPECT_TRUE(graph.IsFollowing(257, 2));
+  EXPECT_EQ(graph.GetEdges(), 2);
+  EXPECT_EQ(graph.GetMemory().followers_, 2);
+}
+
+UTEST(FollowGraph, Add) {
+  follows::FollowGraph graph;
+  graph.Follow(2, 5);
+  graph.Add({{1, 2}, {1, 3}, {2, 4}, {2, 5}});
+  graph.ShrinkToFit();
+  EXPECT_EQ(graph.GetEdges(), 4);
+  EXPECT_EQ(graph.AreFollowed(2, {4, 5, 6}),
+            (std::vector<bool>{true, true, false}));
+  EXPECT_TRUE(graph.IsFollowing(1, 3));
+}
+
+UTEST(FollowSet, BitmapForDenseFollows) {
+  follows::FollowSet follows;
+  for (std::int32_t id = 1; id < 10000; id += 2) {
+    EXPECT_TRUE(follows.Insert(id));
+  }
+  EXPECT_TRUE(follows.IsBitmap());
+  EXPECT_EQ(follows.size(), 5000);
+  EXPECT_LT(follows.GetBytes(), 5000 * sizeof(std::int32_t));
+  EXPECT_TRUE(follows.Contains(9999));
+  EXPECT_FALSE(follows.Contains(2));
+  EXPECT_FALSE(follows.Contains(1000000));
+
+  // Past the end of the bitmap
+  EXPECT_TRUE(follows.Insert(1000000));
+  EXPECT_FALSE(follows.Insert(1000000));
+  EXPECT_TRUE(follows.Contains(1000000));
+  EXPECT_TRUE(follows.Erase(1));
+  EXPECT_FALSE(follows.Erase(1));
+  EXPECT_FALSE(follows.Erase(2000000));
+  EXPECT_EQ(follows.size(), 5000);
+}
+
+UTEST(FollowSet, ArrayForSparseFollows) {
+  follows::FollowSet follows;
+  for (std::int32_t id = 1; id <= 5000; ++id) {
+    follows.Insert(id * 1000);
+  }
+  EXPECT_FALSE(follows.IsBitmap());
+  EXPECT_TRUE(follows.Contains(5000000));
+  EXPECT_FALSE(follows.Contains(4999999));
+}
+
+}  // namespace realworld
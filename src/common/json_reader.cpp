@@ -0,0 +1,383 @@
+#include "json_reader.hpp"
+#include <cstdint>
+#include "fmt/core.h"
+
+namespace realworld::json {
+
+namespace {
+
+// Deeper documents are rejected instead of being skipped recursively
+constexpr std::size_t kMaxDepth{64};
+
+constexpr bool IsWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+void AppendUtf8(std::string& out, std::uint32_t code_point) {
+  if (code_point < 0x80) {
+    out += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    out += static_cast<char>(0xC0 | (code_point >> 6));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    out += static_cast<char>(0xE0 | (code_point >> 12));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code_point >> 18));
+    out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+}  // namespace
+
+Reader::Reader(std::string_view input) : input_{input} {}
+
+Reader::Type Reader::Peek() {
+  // Literals are checked in full, so that a malformed value is reported as
+  // a parse error rather than as a value of the wrong type
+  const auto starts_with = [this](std::string_view literal) {
+    return input_.substr(pos_, literal.size()) == literal;
+  };
+  const auto c = PeekChar();
+  switch (c) {
+    case 'n':
+      if (starts_with("null")) {
+        return Type::kNull;
+      }
+      break;
+    case 't':
+      if (starts_with("true")) {
+        return Type::kBool;
+      }
+      break;
+    case 'f':
+      if (starts_with("false")) {
+        return Type::kBool;
+      }
+      break;
+    case '"':
+      return Type::kString;
+    case '[':
+      return Type::kArray;
+    case '{':
+      return Type::kObject;
+    default:
+      if (c == '-' || IsDigit(c)) {
+        return Type::kNumber;
+      }
+  }
+  Fail("invalid value");
+}
+
+std::string Reader::ReadString() {
+  std::string result;
+  ReadString(result);
+  return result;
+}
+
+void Reader::ReadString(std::string& out) {
+  Expect('"');
+  out.clear();
+  ReadStringBody(out);
+}
+
+bool Reader::SkipNull() {
+  if (PeekChar() != 'n') {
+    return false;
+  }
+  SkipLiteral("null");
+  return true;
+}
+
+void Reader::Skip() {
+  switch (PeekChar()) {
+    case 'n':
+      SkipLiteral("null");
+      break;
+    case 't':
+      SkipLiteral("true");
+      break;
+    case 'f':
+      SkipLiteral("false");
+      break;
+    case '"':
+      SkipString();
+      break;
+    case '[':
+      ReadArray([this] { Skip(); });
+      break;
+    case '{':
+      ReadObject([this](std::string_view) { Skip(); });
+      break;
+    default:
+      SkipNumber();
+  }
+}
+
+bool Reader::IsEnd() {
+  while (pos_ < input_.size() && IsWhitespace(input_[pos_])) {
+    ++pos_;
+  }
+  return pos_ == input_.size();
+}
+
+void Reader::Finish() {
+  if (!IsEnd()) {
+    Fail("unexpected data after the document");
+  }
+}
+
+char Reader::PeekChar() {
+  if (IsEnd()) {
+    Fail("unexpected end of the document");
+  }
+  return input_[pos_];
+}
+
+void Reader::Expect(char c) {
+  if (PeekChar() != c) {
+    Fail(fmt::format("expected '{}'", c));
+  }
+  ++pos_;
+}
+
+void Reader::Fail(std::string_view what) const {
+  throw ParseError{fmt::format("Invalid JSON at offset {}: {}", pos_, what)};
+}
+
+bool Reader::StartObject() {
+  Expect('{');
+  if (++depth_ > kMaxDepth) {
+    Fail("the document is nested too deeply");
+  }
+  if (PeekChar() == '}') {
+    ++pos_;
+    --depth_;
+    return false;
+  }
+  return true;
+}
+
+std::string_view Reader::ReadKey() {
+  Expect('"');
+  const auto begin = pos_;
+  // Keys almost never have escapes, those are returned without a copy
+  while (pos_ < input_.size() && input_[pos_] != '"' &&
+         input_[pos_] != '\\' &&
+         static_cast<unsigned char>(input_[pos_]) >= 0x20) {
+    ++pos_;
+  }
+  std::string_view key;
+  if (pos_ < input_.size() && input_[pos_] == '"') {
+    key = input_.substr(begin, pos_ - begin);
+    ++pos_;
+  } else {
+    pos_ = begin;
+    key_buffer_.clear();
+    ReadStringBody(key_buffer_);
+    key = key_buffer_;
+  }
+  Expect(':');
+  return key;
+}
+
+bool Reader::NextMember() {
+  if (PeekChar() == ',') {
+    ++pos_;
+    return true;
+  }
+  Expect('}');
+  --depth_;
+  return false;
+}
+
+bool Reader::StartArray() {
+  Expect('[');
+  if (++depth_ > kMaxDepth) {
+    Fail("the document is nested too deeply");
+  }
+  if (PeekChar() == ']') {
+    ++pos_;
+    --depth_;
+    return false;
+  }
+  return true;
+}
+
+bool Reader::NextElement() {
+  if (PeekChar() == ',') {
+    ++pos_;
+    return true;
+  }
+  Expect(']');
+  --depth_;
+  return false;
+}
+
+void Reader::ReadStringBody(std::string& out) {
+  while (true) {
+    const auto begin = pos_;
+    while (pos_ < input_.size() && input_[pos_] != '"' &&
+           input_[pos_] != '\\' &&
+           static_cast<unsigned char>(input_[pos_]) >= 0x20) {
+      ++pos_;
+    }
+    out.append(input_.data() + begin, pos_ - begin);
+    if (pos_ == input_.size()) {
+      Fail("unterminated string");
+    }
+    const auto c = input_[pos_++];
+    if (c == '"') {
+      return;
+    }
+    if (c != '\\') {
+      --pos_;
+      Fail("unescaped control character in a string");
+    }
+    if (pos_ == input_.size()) {
+      Fail("unterminated string");
+    }
+    switch (input_[pos_++]) {
+      case '"':
+        out += '"';
+        break;
+      case '\\':
+        out += '\\';
+        break;
+      case '/':
+        out += '/';
+        break;
+      case 'b':
+        out += '\b';
+        break;
+      case 'f':
+        out += '\f';
+        break;
+      case 'n':
+        out += '\n';
+        break;
+      case 'r':
+        out += '\r';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u': {
+        const auto read_code_unit = [this] {
+          if (input_.size() - pos_ < 4) {
+            Fail("truncated \\u escape");
+          }
+          std::uint32_t code_unit{0};
+          for (int i = 0; i < 4; ++i) {
+            const auto value = HexValue(input_[pos_++]);
+            if (value < 0) {
+              Fail("invalid \\u escape");
+            }
+            code_unit = (code_unit << 4) | static_cast<std::uint32_t>(value);
+          }
+          return code_unit;
+        };
+        auto code_point = read_code_unit();
+        if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+          Fail("unpaired surrogate");
+        }
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+          if (input_.substr(pos_, 2) != "\\u") {
+            Fail("unpaired surrogate");
+          }
+          pos_ += 2;
+          const auto low = read_code_unit();
+          if (low < 0xDC00 || low > 0xDFFF) {
+            Fail("unpaired surrogate");
+          }
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+        AppendUtf8(out, code_point);
+        break;
+      }
+      default:
+        --pos_;
+        Fail("invalid escape");
+    }
+  }
+}
+
+void Reader::SkipString() {
+  Expect('"');
+  while (pos_ < input_.size()) {
+    const auto c = input_[pos_++];
+    if (c == '"') {
+      return;
+    }
+    if (static_cast<unsigned char>(c) < 0x20) {
+      --pos_;
+      Fail("unescaped control character in a string");
+    }
+    if (c == '\\') {
+      // Escapes are only validated when the string is read
+      ++pos_;
+    }
+  }
+  Fail("unterminated string");
+}
+
+void Reader::SkipNumber() {
+  const auto skip_digits = [this] {
+    const auto begin = pos_;
+    while (pos_ < input_.size() && IsDigit(input_[pos_])) {
+      ++pos_;
+    }
+    return pos_ - begin;
+  };
+
+  if (input_[pos_] == '-') {
+    ++pos_;
+  }
+  if (pos_ < input_.size() && input_[pos_] == '0') {
+    ++pos_;
+  } else if (skip_digits() == 0) {
+    Fail("invalid value");
+  }
+  if (pos_ < input_.size() && input_[pos_] == '.') {
+    ++pos_;
+    if (skip_digits() == 0) {
+      Fail("invalid number");
+    }
+  }
+  if (pos_ < input_.size() && (input_[pos_] == 'e' || input_[pos_] == 'E')) {
+    ++pos_;
+    if (pos_ < input_.size() && (input_[pos_] == '+' || input_[pos_] == '-')) {
+      ++pos_;
+    }
+    if (skip_digits() == 0) {
+      Fail("invalid number");
+    }
+  }
+}
+
+void Reader::SkipLiteral(std::string_view literal) {
+  if (input_.substr(pos_, literal.size()) != literal) {
+    Fail("invalid value");
+  }
+  pos_ += literal.size();
+}
+
+}  // namespace realworld::json
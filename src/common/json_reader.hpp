@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace realworld::json {
+
+class ParseError final : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+// Pull parser for request bodies. The caller walks the document and decides
+// what to do with every value: strings are unescaped straight into the
+// caller's std::string, everything else is skipped without being decoded.
+// Throws ParseError on malformed JSON.
+class Reader final {
+ public:
+  enum class Type { kNull, kBool, kNumber, kString, kArray, kObject };
+
+  explicit Reader(std::string_view input);
+
+  // Type of the next value, throws if no value can start there
+  Type Peek();
+
+  // Calls on_member(key) for every member of the object. on_member must
+  // consume the value; the key is only valid until then.
+  template <typename OnMember>
+  void ReadObject(OnMember&& on_member);
+
+  // Calls on_element() for every element of the array, on_element must
+  // consume the element.
+  template <typename OnElement>
+  void ReadArray(OnElement&& on_element);
+
+  // The next value must be a string
+  std::string ReadString();
+  void ReadString(std::string& out);
+
+  // Consumes null if it is the next value
+  bool SkipNull();
+
+  void Skip();
+
+  // True if only whitespace is left
+  bool IsEnd();
+
+  // Throws if anything but whitespace is left
+  void Finish();
+
+ private:
+  char PeekChar();
+  void Expect(char c);
+  [[noreturn]] void Fail(std::string_view what) const;
+
+  bool StartObject();
+  std::string_view ReadKey();
+  bool NextMember();
+  bool StartArray();
+  bool NextElement();
+
+  void ReadStringBody(std::string& out);
+  void SkipString();
+  void SkipNumber();
+  void SkipLiteral(std::string_view literal);
+
+  const std::string_view input_;
+  std::size_t pos_{0};
+  std::size_t depth_{0};
+  std::string key_buffer_;
+};
+
+template <typename OnMember>
+void Reader::ReadObject(OnMember&& on_member) {
+  if (!StartObject()) {
+    return;
+  }
+  do {
+    on_member(ReadKey());
+  } while (NextMember());
+}
+
+template <typename OnElement>
+void Reader::ReadArray(OnElement&& on_element) {
+  if (!StartArray()) {
+    return;
+  }
+  do {
+    on_element();
+  } while (NextElement());
+}
+
+}  // namespace realworld::json
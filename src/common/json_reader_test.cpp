@@ -0,0 +1,121 @@
+#include "json_reader.hpp"
+#include <userver/utest/utest.hpp>
+#include <vector>
+#include "utils.hpp"
+
+namespace realworld {
+
+namespace {
+
+// Reads the document and returns the strings it has in document order
+std::vector<std::string> ReadStrings(std::string_view document) {
+  std::vector<std::string> strings;
+  json::Reader reader{document};
+  const auto read_value = [&](const auto& self) -> void {
+    switch (reader.Peek()) {
+      case json::Reader::Type::kString:
+        strings.push_back(reader.ReadString());
+        break;
+      case json::Reader::Type::kObject:
+        reader.ReadObject([&](std::string_view key) {
+          strings.emplace_back(key);
+          self(self);
+        });
+        break;
+      case json::Reader::Type::kArray:
+        reader.ReadArray([&] { self(self); });
+        break;
+      default:
+        reader.Skip();
+    }
+  };
+  read_value(read_value);
+  reader.Finish();
+  return strings;
+}
+
+}  // namespace
+
+UTEST(JsonReader, ValidDocuments) {
+  EXPECT_EQ(ReadStrings(" {} "), std::vector<std::string>{});
+  EXPECT_EQ(ReadStrings("[]"), std::vector<std::string>{});
+  EXPECT_EQ(
+      ReadStrings(R"({"a": [1, -2.5e+3, 0, true, false, null], "b": {}})"),
+      (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(ReadStrings(R"([[["deep"]], "x", {"k": "v"}])"),
+            (std::vector<std::string>{"deep", "x", "k", "v"}));
+}
+
+UTEST(JsonReader, Escapes) {
+  EXPECT_EQ(ReadStrings(R"(["\"\\\/\b\f\n\r\t"])"),
+            std::vector<std::string>{"\"\\/\b\f\n\r\t"});
+  EXPECT_EQ(ReadStrings(R"(["\u0041\u00e9\u4E16"])"),
+            std::vector<std::string>{"A\u00e9\u4e16"});
+  EXPECT_EQ(ReadStrings(R"(["\ud83d\ude00"])"),
+            std::vector<std::string>{"\U0001F600"});
+  EXPECT_EQ(ReadStrings(R"({"k\u0065y": 1})"),
+            std::vector<std::string>{"key"});
+}
+
+UTEST(JsonReader, InvalidDocuments) {
+  const std::vector<std::string_view> invalid_documents{
+      "",
+      "{",
+      "{]",
+      "[1,]",
+      "[1 2]",
+      R"({"a" 1})",
+      R"({"a": 1,})",
+      R"({a: 1})",
+      "[01]",
+      "[1.]",
+      "[1e]",
+      "[-]",
+      "[tru]",
+      "[nul]",
+      R"(["unterminated)",
+      "[\"control\x01\"]",
+      R"(["\x"])",
+      R"(["\u12"])",
+      R"(["\ud83d"])",
+      R"(["\ude00"])",
+      R"(["\ud83dA"])",
+      "{} {}",
+  };
+  for (const auto document : invalid_documents) {
+    EXPECT_THROW(ReadStrings(document), json::ParseError) << document;
+  }
+}
+
+UTEST(JsonReader, DepthLimit) {
+  const std::string shallow = std::string(64, '[') + std::string(64, ']');
+  EXPECT_NO_THROW(ReadStrings(shallow));
+  const std::string deep = std::string(65, '[') + std::string(65, ']');
+  EXPECT_THROW(ReadStrings(deep), json::ParseError);
+}
+
+UTEST(ReadRequestObject, Errors) {
+  const auto read = [](std::string_view body) {
+    std::vector<std::string> keys;
+    utils::ReadRequestObject(
+        body, "user", [&keys](json::Reader& reader, std::string_view key) {
+          keys.emplace_back(key);
+          utils::ReadString(reader, key);
+        });
+    return keys;
+  };
+  EXPECT_EQ(read(""), std::vector<std::string>{});
+  EXPECT_EQ(read(R"({"user": null})"), std::vector<std::string>{});
+  EXPECT_EQ(read(R"({"other": {"a": [1]}, "user": {"a": "b"}})"),
+            std::vector<std::string>{"a"});
+  EXPECT_THROW(read("[]"), errors::MalformedRequestError);
+  EXPECT_THROW(read(R"({"user": {"a": "b"})"), errors::MalformedRequestError);
+  // Not values of the wrong type but no values at all
+  EXPECT_THROW(read(R"({"user": {"a": x}})"), errors::MalformedRequestError);
+  EXPECT_THROW(read(R"({"user": {"a": tru}})"), errors::MalformedRequestError);
+  EXPECT_THROW(read(R"({"user": {"a": +1}})"), errors::MalformedRequestError);
+  EXPECT_THROW(read(R"({"user": []})"), errors::ValidationError);
+  EXPECT_THROW(read(R"({"user": {"a": 1}})"), errors::ValidationError);
+}
+
+}  // namespace realworld
@@ -1,30 +1,308 @@
 #include "jwt.hpp"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <array>
+#include <charconv>
 #include <userver/dynamic_config/storage/component.hpp>
-#include "jwt-cpp/jwt.h"
+#include "base64.hpp"
+#include "fmt/core.h"
 #include "userver/formats/yaml/value_builder.hpp"
 
 namespace realworld::jwt {
 
+namespace {
+
+// base64url of {"alg":"HS256","typ":"JWT"}, the header jwt-cpp produces
+constexpr std::string_view kEncodedHeader{
+    "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9"};
+
+constexpr std::size_t kSha256Size{32};
+constexpr std::size_t kSha256BlockSize{64};
+
+void SkipWhitespace(std::string_view json, std::size_t& pos) {
+  while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' ||
+                               json[pos] == '\n' || json[pos] == '\r')) {
+    ++pos;
+  }
+}
+
+std::optional<std::string_view> ReadString(std::string_view json,
+                                           std::size_t& pos) {
+  if (pos >= json.size() || json[pos] != '"') {
+    return std::nullopt;
+  }
+  const auto begin = ++pos;
+  while (pos < json.size() && json[pos] != '"') {
+    pos += json[pos] == '\\' ? 2 : 1;
+  }
+  if (pos >= json.size()) {
+    return std::nullopt;
+  }
+  return json.substr(begin, pos++ - begin);
+}
+
+// Calls on_member(key, value) for every member of a JSON object whose
+// values are strings, numbers or literals. Values are passed as they are
+// written, strings with the quotes. Returns false for malformed or nested
+// objects, which this service never issues.
+template <typename OnMember>
+bool ForEachMember(std::string_view json, OnMember&& on_member) {
+  std::size_t pos{0};
+  SkipWhitespace(json, pos);
+  if (pos >= json.size() || json[pos++] != '{') {
+    return false;
+  }
+  SkipWhitespace(json, pos);
+  if (pos < json.size() && json[pos] == '}') {
+    ++pos;
+  } else {
+    while (true) {
+      SkipWhitespace(json, pos);
+      const auto key = ReadString(json, pos);
+      SkipWhitespace(json, pos);
+      if (!key || pos >= json.size() || json[pos++] != ':') {
+        return false;
+      }
+      SkipWhitespace(json, pos);
+      std::optional<std::string_view> value;
+      const auto begin = pos;
+      if (pos < json.size() && json[pos] == '"') {
+        if (ReadString(json, pos)) {
+          value = json.substr(begin, pos - begin);
+        }
+      } else {
+        while (pos < json.size() && json[pos] != ',' && json[pos] != '}' &&
+               json[pos] != ' ' && json[pos] != '{' && json[pos] != '[') {
+          ++pos;
+        }
+        if (pos != begin && pos < json.size() && json[pos] != '{' &&
+            json[pos] != '[') {
+          value = json.substr(begin, pos - begin);
+        }
+      }
+      if (!value) {
+        return false;
+      }
+      on_member(*key, *value);
+      SkipWhitespace(json, pos);
+      if (pos >= json.size()) {
+        return false;
+      }
+      if (json[pos] == '}') {
+        ++pos;
+        break;
+      }
+      if (json[pos++] != ',') {
+        return false;
+      }
+    }
+  }
+  SkipWhitespace(json, pos);
+  return pos == json.size();
+}
+
+std::optional<std::int64_t> ParseInteger(std::string_view value) {
+  std::int64_t result{};
+  const auto* end = value.data() + value.size();
+  const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  if (ec != std::errc{} || ptr != end) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+std::chrono::system_clock::time_point ToTimePoint(std::int64_t seconds) {
+  return std::chrono::system_clock::time_point{std::chrono::seconds{seconds}};
+}
+
+struct MdCtxDeleter final {
+  void operator()(EVP_MD_CTX* ctx) const noexcept { EVP_MD_CTX_free(ctx); }
+};
+
+using MdCtxPtr = std::unique_ptr<EVP_MD_CTX, MdCtxDeleter>;
+
+void CheckOpenSsl(int result, std::string_view operation) {
+  if (result != 1) {
+    throw std::runtime_error(fmt::format("{} failed", operation));
+  }
+}
+
+MdCtxPtr MakeSha256Context(const std::array<unsigned char, kSha256BlockSize>&
+                               padded_key) {
+  MdCtxPtr ctx{EVP_MD_CTX_new()};
+  if (!ctx) {
+    throw std::runtime_error("EVP_MD_CTX_new failed");
+  }
+  CheckOpenSsl(EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr),
+               "EVP_DigestInit_ex");
+  CheckOpenSsl(
+      EVP_DigestUpdate(ctx.get(), padded_key.data(), padded_key.size()),
+      "EVP_DigestUpdate");
+  return ctx;
+}
+
+}  // namespace
+
+// HMAC-SHA256 (RFC 2104) with the digest states after the inner and outer
+// padded keys precomputed, so signing only hashes the message.
+class JWTManager::HmacKey final {
+ public:
+  using Digest = std::array<unsigned char, kSha256Size>;
+
+  explicit HmacKey(std::string_view key) {
+    std::array<unsigned char, kSha256BlockSize> block_key{};
+    if (key.size() > kSha256BlockSize) {
+      unsigned int size{0};
+      CheckOpenSsl(EVP_Digest(key.data(), key.size(), block_key.data(), &size,
+                              EVP_sha256(), nullptr),
+                   "EVP_Digest");
+    } else {
+      std::copy(key.begin(), key.end(), block_key.begin());
+    }
+    auto padded_key = block_key;
+    for (auto& byte : padded_key) {
+      byte ^= 0x36;
+    }
+    inner_ = MakeSha256Context(padded_key);
+    padded_key = block_key;
+    for (auto& byte : padded_key) {
+      byte ^= 0x5c;
+    }
+    outer_ = MakeSha256Context(padded_key);
+  }
+
+  Digest Sign(std::string_view data) const {
+    // A context per thread avoids an allocation per signature; signing
+    // never suspends the coroutine, so it is not shared between tasks.
+    thread_local const MdCtxPtr ctx{EVP_MD_CTX_new()};
+    if (!ctx) {
+      throw std::runtime_error("EVP_MD_CTX_new failed");
+    }
+    Digest inner_digest{};
+    Digest digest{};
+    unsigned int size{0};
+    CheckOpenSsl(EVP_MD_CTX_copy_ex(ctx.get(), inner_.get()),
+                 "EVP_MD_CTX_copy_ex");
+    CheckOpenSsl(EVP_DigestUpdate(ctx.get(), data.data(), data.size()),
+                 "EVP_DigestUpdate");
+    CheckOpenSsl(EVP_DigestFinal_ex(ctx.get(), inner_digest.data(), &size),
+                 "EVP_DigestFinal_ex");
+    CheckOpenSsl(EVP_MD_CTX_copy_ex(ctx.get(), outer_.get()),
+                 "EVP_MD_CTX_copy_ex");
+    CheckOpenSsl(
+        EVP_DigestUpdate(ctx.get(), inner_digest.data(), inner_digest.size()),
+        "EVP_DigestUpdate");
+    CheckOpenSsl(EVP_DigestFinal_ex(ctx.get(), digest.data(), &size),
+                 "EVP_DigestFinal_ex");
+    return digest;
+  }
+
+ private:
+  MdCtxPtr inner_;
+  MdCtxPtr outer_;
+};
+
 JWTConfig::JWTConfig(const userver::formats::json::Value& config)
     : secret_key_{config["secret_key"].As<std::string>()},
       token_expiration_time_{
           config["jwt_expiration_time"].As<std::chrono::seconds>()} {}
 
-JWTManager::JWTManager(const JWTConfig& config) : config_{config} {
-  verifier_.allow_algorithm(::jwt::algorithm::hs256{config_.secret_key_});
-}
+JWTManager::JWTManager(const JWTConfig& config)
+    : config_{config},
+      hmac_key_{std::make_unique<const HmacKey>(config_.secret_key_)} {}
+
+JWTManager::~JWTManager() = default;
 
 std::string JWTManager::GenerateToken(std::int64_t id) const {
-  return ::jwt::create()
-      .set_type("JWT")
-      .set_expires_at(std::chrono::system_clock::now() +
-                      config_.token_expiration_time_)
-      .set_payload_claim("id", ::jwt::claim(picojson::value(id)))
-      .sign(::jwt::algorithm::hs256{config_.secret_key_});
+  const auto expires_at =
+      std::chrono::duration_cast<std::chrono::seconds>(
+          (std::chrono::system_clock::now() + config_.token_expiration_time_)
+              .time_since_epoch())
+          .count();
+  std::string token;
+  token.reserve(128);
+  token += kEncodedHeader;
+  token += '.';
+  // Claims are in the same order as jwt-cpp writes them
+  base64::AppendUrl(token,
+                  fmt::format(R"({{"exp":{},"id":{}}})", expires_at, id));
+  const auto signature = hmac_key_->Sign(token);
+  token += '.';
+  base64::AppendUrl(
+      token, std::string_view{reinterpret_cast<const char*>(signature.data()),
+                              signature.size()});
+  return token;
 }
 
-void JWTManager::VerifyToken(const DecodedToken& decoded_token) const {
-  verifier_.verify(decoded_token);
+TokenPayload JWTManager::VerifyToken(std::string_view token) const {
+  const auto header_end = token.find('.');
+  const auto payload_end = token.find('.', header_end + 1);
+  if (header_end == std::string_view::npos ||
+      payload_end == std::string_view::npos ||
+      token.find('.', payload_end + 1) != std::string_view::npos) {
+    throw TokenVerificationError{"malformed token"};
+  }
+
+  const auto signature = base64::DecodeUrl(token.substr(payload_end + 1));
+  const auto expected_signature =
+      hmac_key_->Sign(token.substr(0, payload_end));
+  if (!signature || signature->size() != expected_signature.size() ||
+      CRYPTO_memcmp(signature->data(), expected_signature.data(),
+                    expected_signature.size()) != 0) {
+    throw TokenVerificationError{"invalid signature"};
+  }
+
+  const auto header = base64::DecodeUrl(token.substr(0, header_end));
+  bool is_hs256{false};
+  if (!header || !ForEachMember(*header, [&is_hs256](std::string_view key,
+                                                     std::string_view value) {
+        if (key == "alg") {
+          is_hs256 = value == R"("HS256")";
+        }
+      })) {
+    throw TokenVerificationError{"malformed header"};
+  }
+  if (!is_hs256) {
+    throw TokenVerificationError{"unexpected algorithm"};
+  }
+
+  const auto payload = base64::DecodeUrl(
+      token.substr(header_end + 1, payload_end - header_end - 1));
+  std::optional<std::int64_t> id;
+  std::optional<std::int64_t> exp;
+  std::optional<std::int64_t> nbf;
+  std::optional<std::int64_t> iat;
+  bool are_claims_valid{true};
+  if (!payload ||
+      !ForEachMember(*payload, [&](std::string_view key,
+                                   std::string_view value) {
+        auto* claim = key == "id"    ? &id
+                      : key == "exp" ? &exp
+                      : key == "nbf" ? &nbf
+                      : key == "iat" ? &iat
+                                     : nullptr;
+        if (claim) {
+          *claim = ParseInteger(value);
+          are_claims_valid = are_claims_valid && claim->has_value();
+        }
+      }) ||
+      !are_claims_valid || !id) {
+    throw TokenVerificationError{"malformed payload"};
+  }
+
+  // Same checks as the default jwt-cpp verifier with zero leeway
+  const auto now = std::chrono::system_clock::now();
+  if ((exp && now > ToTimePoint(*exp)) || (nbf && now < ToTimePoint(*nbf)) ||
+      (iat && now < ToTimePoint(*iat))) {
+    throw TokenVerificationError{"token is expired or not yet valid"};
+  }
+
+  TokenPayload result;
+  result.id_ = *id;
+  if (exp) {
+    result.expires_at_ = ToTimePoint(*exp);
+  }
+  return result;
 }
 
-}  // namespace realworld::jwt
\ No newline at end of file
+}  // namespace realworld::jwt
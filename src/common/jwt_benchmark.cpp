@@ -0,0 +1,67 @@
+#include "jwt.hpp"
+#include <benchmark/benchmark.h>
+#include <userver/formats/json/serialize_duration.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include "jwt-cpp/jwt.h"
+
+namespace realworld {
+
+namespace {
+
+constexpr std::int64_t kUserId{666};
+const std::string kSecretKey{"secret_key"};
+
+jwt::JWTConfig GetTestConfig() {
+  userver::formats::json::ValueBuilder builder;
+  builder["secret_key"] = kSecretKey;
+  builder["jwt_expiration_time"] = std::chrono::seconds{86400};
+  return jwt::JWTConfig{builder.ExtractValue()};
+}
+
+}  // namespace
+
+void GenerateTokenJwtCppBenchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ::jwt::create()
+            .set_type("JWT")
+            .set_expires_at(std::chrono::system_clock::now() +
+                            std::chrono::seconds{86400})
+            .set_payload_claim("id", ::jwt::claim(picojson::value(kUserId)))
+            .sign(::jwt::algorithm::hs256{kSecretKey}));
+  }
+}
+BENCHMARK(GenerateTokenJwtCppBenchmark);
+
+void GenerateTokenBenchmark(benchmark::State& state) {
+  const jwt::JWTManager jwt_manager{GetTestConfig()};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(jwt_manager.GenerateToken(kUserId));
+  }
+}
+BENCHMARK(GenerateTokenBenchmark);
+
+void VerifyTokenJwtCppBenchmark(benchmark::State& state) {
+  const jwt::JWTManager jwt_manager{GetTestConfig()};
+  const auto token = jwt_manager.GenerateToken(kUserId);
+  const auto verifier =
+      ::jwt::verify().allow_algorithm(::jwt::algorithm::hs256{kSecretKey});
+  for (auto _ : state) {
+    const auto decoded_token = ::jwt::decode(token);
+    verifier.verify(decoded_token);
+    benchmark::DoNotOptimize(
+        decoded_token.get_payload_claim("id").as_integer());
+  }
+}
+BENCHMARK(VerifyTokenJwtCppBenchmark);
+
+void VerifyTokenBenchmark(benchmark::State& state) {
+  const jwt::JWTManager jwt_manager{GetTestConfig()};
+  const auto token = jwt_manager.GenerateToken(kUserId);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(jwt_manager.VerifyToken(token));
+  }
+}
+BENCHMARK(VerifyTokenBenchmark);
+
+}  // namespace realworld
@@ -2,6 +2,8 @@
 #include <userver/formats/json/serialize_duration.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/utest/utest.hpp>
+#include <vector>
+#include "jwt-cpp/jwt.h"
 
 namespace realworld {
 
@@ -9,13 +11,43 @@ namespace {
 
 constexpr std::int64_t kUserId{666};
 
-userver::formats::json::Value GetTestConfigJson() {
+userver::formats::json::Value GetTestConfigJson(
+    std::string_view secret_key = "secret_key") {
   userver::formats::json::ValueBuilder builder;
-  builder["secret_key"] = "secret_key";
+  builder["secret_key"] = std::string{secret_key};
   builder["jwt_expiration_time"] = std::chrono::seconds{86400};
   return builder.ExtractValue();
 }
 
+// How the tokens were issued before JWTManager stopped using jwt-cpp
+std::string GenerateJwtCppToken(
+    std::int64_t id, std::chrono::system_clock::time_point expires_at,
+    const std::string& secret_key = "secret_key") {
+  return ::jwt::create()
+      .set_type("JWT")
+      .set_expires_at(expires_at)
+      .set_payload_claim("id", ::jwt::claim(picojson::value(id)))
+      .sign(::jwt::algorithm::hs256{secret_key});
+}
+
+std::vector<std::string> SplitToken(const std::string& token) {
+  std::vector<std::string> parts;
+  std::size_t begin{0};
+  for (auto end = token.find('.'); end != std::string::npos;
+       begin = end + 1, end = token.find('.', begin)) {
+    parts.push_back(token.substr(begin, end - begin));
+  }
+  parts.push_back(token.substr(begin));
+  return parts;
+}
+
+std::string ReplacePart(const std::string& token, std::size_t index,
+                        const std::string& part) {
+  auto parts = SplitToken(token);
+  parts.at(index) = part;
+  return parts.at(0) + '.' + parts.at(1) + '.' + parts.at(2);
+}
+
 }  // namespace
 
 UTEST(JWTManager, GenerateToken) {
@@ -25,18 +57,102 @@ UTEST(JWTManager, GenerateToken) {
   const auto decoded_token = ::jwt::decode(token);
   const auto id = decoded_token.get_payload_claim("id").as_integer();
   ASSERT_EQ(id, kUserId);
+  EXPECT_EQ(decoded_token.get_algorithm(), "HS256");
+  EXPECT_EQ(decoded_token.get_type(), "JWT");
+  EXPECT_GT(decoded_token.get_expires_at(), std::chrono::system_clock::now());
+  EXPECT_NO_THROW(
+      ::jwt::verify()
+          .allow_algorithm(::jwt::algorithm::hs256{config.secret_key_})
+          .verify(decoded_token));
 }
 
 UTEST(JWTManager, VerifyToken) {
   const jwt::JWTConfig config{GetTestConfigJson()};
   const jwt::JWTManager jwt_manager{config};
   const auto token = jwt_manager.GenerateToken(kUserId);
-  const auto decoded_token = ::jwt::decode(token);
   try {
-    jwt_manager.VerifyToken(decoded_token);
+    const auto payload = jwt_manager.VerifyToken(token);
+    EXPECT_EQ(payload.id_, kUserId);
+    EXPECT_TRUE(payload.expires_at_.has_value());
   } catch (const std::exception& ex) {
     FAIL() << "JWTManager::VerifyToken failed";
   }
 }
 
-}  // namespace realworld
\ No newline at end of file
+UTEST(JWTManager, VerifyJwtCppToken) {
+  const jwt::JWTConfig config{GetTestConfigJson()};
+  const jwt::JWTManager jwt_manager{config};
+  const auto expires_at = std::chrono::time_point_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now() + std::chrono::hours{1});
+  const auto payload =
+      jwt_manager.VerifyToken(GenerateJwtCppToken(kUserId, expires_at));
+  EXPECT_EQ(payload.id_, kUserId);
+  EXPECT_EQ(payload.expires_at_, expires_at);
+
+  const auto no_expiration_token =
+      ::jwt::create()
+          .set_payload_claim("id", ::jwt::claim(picojson::value(kUserId)))
+          .sign(::jwt::algorithm::hs256{config.secret_key_});
+  EXPECT_FALSE(jwt_manager.VerifyToken(no_expiration_token).expires_at_);
+}
+
+UTEST(JWTManager, LongSecretKey) {
+  const std::string secret_key(100, 'k');
+  const jwt::JWTConfig config{GetTestConfigJson(secret_key)};
+  const jwt::JWTManager jwt_manager{config};
+  const auto expires_at =
+      std::chrono::system_clock::now() + std::chrono::hours{1};
+  EXPECT_EQ(jwt_manager
+                .VerifyToken(GenerateJwtCppToken(kUserId, expires_at,
+                                                 secret_key))
+                .id_,
+            kUserId);
+  EXPECT_NO_THROW(
+      ::jwt::verify()
+          .allow_algorithm(::jwt::algorithm::hs256{secret_key})
+          .verify(::jwt::decode(jwt_manager.GenerateToken(kUserId))));
+}
+
+UTEST(JWTManager, RejectInvalidTokens) {
+  const jwt::JWTConfig config{GetTestConfigJson()};
+  const jwt::JWTManager jwt_manager{config};
+  const auto token = jwt_manager.GenerateToken(kUserId);
+  const auto other_token =
+      jwt::JWTManager{config}.GenerateToken(kUserId + 1);
+  const auto expires_at =
+      std::chrono::system_clock::now() + std::chrono::hours{1};
+
+  const std::vector<std::string> invalid_tokens{
+      "",
+      "..",
+      token.substr(0, token.rfind('.')),
+      token + ".",
+      token.substr(0, token.size() - 1),
+      ReplacePart(token, 1, SplitToken(other_token).at(1)),
+      ReplacePart(token, 2, "AAAA"),
+      GenerateJwtCppToken(kUserId, expires_at, "other_secret_key"),
+      GenerateJwtCppToken(kUserId,
+                          std::chrono::system_clock::now() -
+                              std::chrono::seconds{10}),
+      ::jwt::create()
+          .set_payload_claim("id", ::jwt::claim(picojson::value(kUserId)))
+          .sign(::jwt::algorithm::none{}),
+      ::jwt::create()
+          .set_expires_at(expires_at)
+          .sign(::jwt::algorithm::hs256{config.secret_key_}),
+      ::jwt::create()
+          .set_payload_claim("id", ::jwt::claim(std::string{"666"}))
+          .sign(::jwt::algorithm::hs256{config.secret_key_}),
+      ::jwt::create()
+          .set_payload_claim("id", ::jwt::claim(picojson::value(kUserId)))
+          .set_not_before(expires_at)
+          .sign(::jwt::algorithm::hs256{config.secret_key_}),
+  };
+  for (const auto& invalid_token : invalid_tokens) {
+    EXPECT_THROW(jwt_manager.VerifyToken(invalid_token),
+                 jwt::TokenVerificationError)
+        << invalid_token;
+  }
+}
+
+}  // namespace realworld
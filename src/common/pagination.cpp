@@ -0,0 +1,132 @@
+#include "pagination.hpp"
+#include <charconv>
+#include <type_traits>
+#include "base64.hpp"
+#include "errors.hpp"
+#include "fmt/core.h"
+
+namespace realworld::pagination {
+
+namespace {
+
+// Big-endian microseconds since the epoch followed by the id
+constexpr std::size_t kCursorSize{sizeof(std::int64_t) + sizeof(std::int32_t)};
+
+std::optional<std::int32_t> ParseInt(std::string_view value) {
+  std::int32_t result{};
+  const auto* end = value.data() + value.size();
+  const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  if (ec != std::errc{} || ptr != end) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+std::int64_t ToMicroseconds(std::chrono::system_clock::time_point time_point) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             time_point.time_since_epoch())
+      .count();
+}
+
+template <typename T>
+void AppendBigEndian(std::string& out, T value) {
+  const auto bits = static_cast<std::make_unsigned_t<T>>(value);
+  for (int shift = static_cast<int>(sizeof(T) - 1) * 8; shift >= 0;
+       shift -= 8) {
+    out += static_cast<char>((bits >> shift) & 0xFF);
+  }
+}
+
+template <typename T>
+T ReadBigEndian(std::string_view data) {
+  std::make_unsigned_t<T> bits{0};
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    bits = (bits << 8) | static_cast<unsigned char>(data[i]);
+  }
+  return static_cast<T>(bits);
+}
+
+}  // namespace
+
+std::string EncodeCursor(const Cursor& cursor) {
+  std::string data;
+  data.reserve(kCursorSize);
+  AppendBigEndian(data, ToMicroseconds(cursor.created_at_));
+  AppendBigEndian(data, cursor.id_);
+  std::string token;
+  base64::AppendUrl(token, data);
+  return token;
+}
+
+std::optional<std::int64_t> Page::CursorCreatedAt() const {
+  if (!cursor_) {
+    return std::nullopt;
+  }
+  return ToMicroseconds(cursor_->created_at_);
+}
+
+std::optional<std::int32_t> Page::CursorId() const {
+  if (!cursor_) {
+    return std::nullopt;
+  }
+  return cursor_->id_;
+}
+
+std::int32_t ParseLimit(std::string_view value) {
+  const auto limit = ParseInt(value);
+  if (!limit || *limit < 1 || *limit > kMaxLimit) {
+    throw errors::ValidationError{errors::ErrorBuilder{
+        "limit", fmt::format("must be an integer from 1 to {}", kMaxLimit)}};
+  }
+  return *limit;
+}
+
+std::int32_t ParseOffset(std::string_view value) {
+  const auto offset = ParseInt(value);
+  if (!offset || *offset < 0) {
+    throw errors::ValidationError{
+        errors::ErrorBuilder{"offset", "must be a non-negative integer"}};
+  }
+  return *offset;
+}
+
+Cursor ParseCursor(std::string_view value) {
+  const auto data = base64::DecodeUrl(value);
+  if (!data || data->size() != kCursorSize) {
+    throw errors::ValidationError{errors::ErrorBuilder{"cursor", "invalid"}};
+  }
+  const std::chrono::microseconds created_at{
+      ReadBigEndian<std::int64_t>(*data)};
+  // A forged value must not overflow the conversion to the clock's ticks
+  constexpr auto kMaxCreatedAt =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::duration::max());
+  if (created_at > kMaxCreatedAt || created_at < -kMaxCreatedAt) {
+    throw errors::ValidationError{errors::ErrorBuilder{"cursor", "invalid"}};
+  }
+  Cursor cursor;
+  cursor.created_at_ = std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          created_at)};
+  cursor.id_ = ReadBigEndian<std::int32_t>(
+      std::string_view{*data}.substr(sizeof(std::int64_t)));
+  return cursor;
+}
+
+Page ParsePage(const userver::server::http::HttpRequest& request,
+               std::int32_t default_limit) {
+  Page page;
+  page.limit_ = default_limit;
+  if (request.HasArg("limit")) {
+    page.limit_ = ParseLimit(request.GetArg("limit"));
+  }
+  if (request.HasArg("offset")) {
+    page.offset_ = ParseOffset(request.GetArg("offset"));
+  }
+  if (request.HasArg("cursor")) {
+    page.cursor_ = ParseCursor(request.GetArg("cursor"));
+  }
+  return page;
+}
+
+}  // namespace realworld::pagination
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "userver/server/http/http_request.hpp"
+
+namespace realworld::pagination {
+
+inline constexpr std::int32_t kDefaultLimit{20};
+inline constexpr std::int32_t kMaxLimit{100};
+
+// Position after the last row of a page ordered by (created_at, id),
+// newest first for articles and oldest first for comments. Clients get it
+// as an opaque token and pass it back as ?cursor=.
+struct Cursor final {
+  std::chrono::system_clock::time_point created_at_;
+  std::int32_t id_{};
+};
+
+std::string EncodeCursor(const Cursor& cursor);
+
+struct Page final {
+  std::int32_t limit_{kDefaultLimit};
+  std::int32_t offset_{0};
+  std::optional<Cursor> cursor_;
+
+  // Query arguments of the cursor, NULL without one. created_at is passed
+  // as microseconds since the epoch, see db::sql.
+  std::optional<std::int64_t> CursorCreatedAt() const;
+  std::optional<std::int32_t> CursorId() const;
+};
+
+// Parsers of the query arguments, throw errors::ValidationError
+std::int32_t ParseLimit(std::string_view value);
+std::int32_t ParseOffset(std::string_view value);
+Cursor ParseCursor(std::string_view value);
+
+// Reads the limit, offset and cursor query arguments
+Page ParsePage(const userver::server::http::HttpRequest& request,
+               std::int32_t default_limit = kDefaultLimit);
+
+}  // namespace realworld::pagination
@@ -0,0 +1,57 @@
+#include "pagination.hpp"
+#include <limits>
+#include <userver/utest/utest.hpp>
+#include <vector>
+#include "errors.hpp"
+
+namespace realworld {
+
+UTEST(Pagination, CursorRoundTrip) {
+  const std::vector<pagination::Cursor> cursors{
+      {std::chrono::system_clock::time_point{}, 0},
+      {std::chrono::system_clock::time_point{std::chrono::seconds{1700000000} +
+                                             std::chrono::microseconds{123456}},
+       42},
+      {std::chrono::system_clock::time_point{std::chrono::seconds{-1}},
+       std::numeric_limits<std::int32_t>::max()},
+  };
+  for (const auto& cursor : cursors) {
+    const auto token = pagination::EncodeCursor(cursor);
+    EXPECT_EQ(token.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                      "abcdefghijklmnopqrstuvwxyz0123456789-_"),
+              std::string::npos);
+    const auto parsed = pagination::ParseCursor(token);
+    EXPECT_EQ(parsed.created_at_, cursor.created_at_);
+    EXPECT_EQ(parsed.id_, cursor.id_);
+  }
+}
+
+UTEST(Pagination, InvalidCursor) {
+  const auto token = pagination::EncodeCursor(
+      {std::chrono::system_clock::time_point{std::chrono::seconds{1}}, 1});
+  for (const auto& value : {std::string{}, token.substr(1), token + "AAAA",
+                           "!" + token.substr(1), std::string{"////////"},
+                           // Microseconds beyond the range of the clock
+                           std::string{"f_________8AAAAB"}}) {
+    EXPECT_THROW(pagination::ParseCursor(value), errors::ValidationError)
+        << value;
+  }
+}
+
+UTEST(Pagination, ParseNumbers) {
+  EXPECT_EQ(pagination::ParseLimit("1"), 1);
+  EXPECT_EQ(pagination::ParseLimit("100"), pagination::kMaxLimit);
+  EXPECT_EQ(pagination::ParseOffset("0"), 0);
+  EXPECT_EQ(pagination::ParseOffset("100000"), 100000);
+  for (const auto value : {"", "0", "-1", "101", "1.5", "10a", " 10", "+10",
+                           "99999999999999999999"}) {
+    EXPECT_THROW(pagination::ParseLimit(value), errors::ValidationError)
+        << value;
+  }
+  for (const auto value : {"", "-1", "1e3", "abc", "2147483648"}) {
+    EXPECT_THROW(pagination::ParseOffset(value), errors::ValidationError)
+        << value;
+  }
+}
+
+}  // namespace realworld
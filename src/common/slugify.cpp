@@ -5,10 +5,12 @@
 
 namespace realworld::slug {
 
-std::string Slugify(const std::string& str) {
+namespace {
+
+std::unique_ptr<icu::Transliterator> CreateTransliterator() {
   UErrorCode status{U_ZERO_ERROR};
   UParseError parse_error{};
-  const auto transliterator =
+  auto transliterator =
       std::unique_ptr<icu::Transliterator>{icu::Transliterator::createFromRules(
           "Slugify",
           ":: Any-Latin;"
@@ -25,10 +27,70 @@ std::string Slugify(const std::string& str) {
     throw std::runtime_error(fmt::format(
         "icu::Transliterator::createFromRules failed with status {}", status));
   }
+  return transliterator;
+}
+
+// Compiling the rules is expensive, so they are compiled once and every
+// worker thread gets its own clone: icu::Transliterator is not thread-safe,
+// and transliterate() never suspends the coroutine, so a thread_local
+// instance cannot be shared between concurrently running tasks.
+const icu::Transliterator& GetTransliterator() {
+  static const auto prototype = CreateTransliterator();
+  thread_local const std::unique_ptr<icu::Transliterator> transliterator{
+      prototype->clone()};
+  return *transliterator;
+}
+
+// ASCII characters of the [:Punctuation:] and [:Symbol:] classes, which
+// the rules remove. Control characters are kept as is.
+constexpr bool IsRemovedAscii(char c) {
+  return (c >= '!' && c <= '/') || (c >= ':' && c <= '@') ||
+         (c >= '[' && c <= '`') || (c >= '{' && c <= '~');
+}
+
+}  // namespace
+
+namespace impl {
+
+std::optional<std::string> SlugifyAscii(std::string_view str) {
+  std::string slug;
+  slug.reserve(str.size());
+  for (const auto c : str) {
+    if (static_cast<unsigned char>(c) >= 0x80) {
+      return std::nullopt;
+    }
+    if (IsRemovedAscii(c)) {
+      continue;
+    }
+    if (c == ' ') {
+      // Runs of spaces collapse into one separator
+      if (!slug.empty() && slug.back() == '-') {
+        continue;
+      }
+      slug.push_back('-');
+    } else if (c >= 'A' && c <= 'Z') {
+      slug.push_back(static_cast<char>(c - 'A' + 'a'));
+    } else {
+      slug.push_back(c);
+    }
+  }
+  return slug;
+}
+
+std::string SlugifyTransliterate(const std::string& str) {
   auto unicode_str = icu::UnicodeString::fromUTF8(str);
-  transliterator->transliterate(unicode_str);
+  GetTransliterator().transliterate(unicode_str);
   std::string slug;
   return unicode_str.toUTF8String(slug);
 }
 
-}  // namespace realworld::slug
\ No newline at end of file
+}  // namespace impl
+
+std::string Slugify(const std::string& str) {
+  if (auto slug = impl::SlugifyAscii(str)) {
+    return std::move(*slug);
+  }
+  return impl::SlugifyTransliterate(str);
+}
+
+}  // namespace realworld::slug
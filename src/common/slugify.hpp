@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include "unicode/translit.h"
 #include "userver/formats/json/value.hpp"
 
@@ -9,4 +11,14 @@ namespace realworld::slug {
 
 std::string Slugify(const std::string& str);
 
-}  // namespace realworld::slug
\ No newline at end of file
+namespace impl {
+
+// Same result as the ICU rules for pure-ASCII input, without ICU.
+// Returns std::nullopt if the input contains non-ASCII bytes.
+std::optional<std::string> SlugifyAscii(std::string_view str);
+
+std::string SlugifyTransliterate(const std::string& str);
+
+}  // namespace impl
+
+}  // namespace realworld::slug
@@ -0,0 +1,75 @@
+#include "slugify.hpp"
+#include <benchmark/benchmark.h>
+#include "fmt/core.h"
+
+namespace realworld {
+
+namespace {
+
+constexpr std::string_view kAsciiTitle{
+    "How to train your dragon: a practical guide, part 2"};
+constexpr std::string_view kCyrillicTitle{
+    "Как приручить дракона: практическое руководство, часть 2"};
+constexpr std::string_view kCjkTitle{"如何驯服你的龙：实用指南，第二部分"};
+
+// Slugify as it was before the transliterator was cached: the rules are
+// compiled on every call.
+std::string SlugifyUncached(const std::string& str) {
+  UErrorCode status{U_ZERO_ERROR};
+  UParseError parse_error{};
+  const auto transliterator =
+      std::unique_ptr<icu::Transliterator>{icu::Transliterator::createFromRules(
+          "Slugify",
+          ":: Any-Latin;"
+          ":: [:Nonspacing Mark:] Remove;"
+          ":: [:Punctuation:] Remove;"
+          ":: [:Symbol:] Remove;"
+          ":: Latin-ASCII;"
+          ":: Lower();"
+          "' ' {' '} > ;"
+          "::NULL;"
+          "[:Separator:] > '-'",
+          UTRANS_FORWARD, parse_error, status)};
+  if (status != U_ZERO_ERROR) {
+    throw std::runtime_error(fmt::format(
+        "icu::Transliterator::createFromRules failed with status {}", status));
+  }
+  auto unicode_str = icu::UnicodeString::fromUTF8(str);
+  transliterator->transliterate(unicode_str);
+  std::string slug;
+  return unicode_str.toUTF8String(slug);
+}
+
+const std::string& GetTitle(std::int64_t index) {
+  static const std::string kTitles[]{std::string{kAsciiTitle},
+                                     std::string{kCyrillicTitle},
+                                     std::string{kCjkTitle}};
+  return kTitles[index];
+}
+
+void SetLabel(benchmark::State& state) {
+  static constexpr std::string_view kLabels[]{"ascii", "cyrillic", "cjk"};
+  state.SetLabel(std::string{kLabels[state.range(0)]});
+}
+
+}  // namespace
+
+void SlugifyUncachedBenchmark(benchmark::State& state) {
+  const auto& title = GetTitle(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SlugifyUncached(title));
+  }
+  SetLabel(state);
+}
+BENCHMARK(SlugifyUncachedBenchmark)->DenseRange(0, 2);
+
+void SlugifyBenchmark(benchmark::State& state) {
+  const auto& title = GetTitle(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(slug::Slugify(title));
+  }
+  SetLabel(state);
+}
+BENCHMARK(SlugifyBenchmark)->DenseRange(0, 2);
+
+}  // namespace realworld
@@ -0,0 +1,44 @@
+#include "slugify.hpp"
+#include <random>
+#include <userver/utest/utest.hpp>
+
+namespace realworld {
+
+namespace {
+
+std::string MakeRandomAscii(std::mt19937& rng) {
+  std::string str(rng() % 32, ' ');
+  for (auto& c : str) {
+    // Every fourth character is a space to exercise separator collapsing
+    c = rng() % 4 ? static_cast<char>(rng() % 128) : ' ';
+  }
+  return str;
+}
+
+}  // namespace
+
+UTEST(Slugify, Ascii) {
+  ASSERT_EQ(slug::Slugify("How to train your dragon"),
+            "how-to-train-your-dragon");
+  ASSERT_EQ(slug::Slugify("  Spaces  -  and, punctuation!? "),
+            "-spaces-and-punctuation-");
+  ASSERT_EQ(slug::Slugify("C++ & $ymbols 2023"), "c-ymbols-2023");
+}
+
+UTEST(Slugify, NonAscii) {
+  ASSERT_EQ(slug::Slugify("Привет мир"), "privet-mir");
+  ASSERT_EQ(slug::Slugify("Crème brûlée"), "creme-brulee");
+  ASSERT_FALSE(slug::impl::SlugifyAscii("Crème brûlée"));
+}
+
+UTEST(Slugify, AsciiFastPathMatchesTransliterator) {
+  std::mt19937 rng{42};
+  for (int i = 0; i < 10000; ++i) {
+    const auto str = MakeRandomAscii(rng);
+    const auto fast = slug::impl::SlugifyAscii(str);
+    ASSERT_TRUE(fast);
+    ASSERT_EQ(*fast, slug::impl::SlugifyTransliterate(str)) << str;
+  }
+}
+
+}  // namespace realworld
@@ -0,0 +1,92 @@
+#include "tag_set.hpp"
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include "userver/formats/json/serialize.hpp"
+#include "userver/formats/json/value_builder.hpp"
+
+namespace realworld::tags {
+
+namespace {
+
+constexpr std::string_view kBodyBegin{R"({"tags":[)"};
+constexpr std::string_view kBodyEnd{"]}"};
+
+bool Ranks(const Tag& lhs, const Tag& rhs) {
+  if (lhs.articles_count_ != rhs.articles_count_) {
+    return lhs.articles_count_ > rhs.articles_count_;
+  }
+  return lhs.name_ < rhs.name_;
+}
+
+}  // namespace
+
+TagSet::TagSet() : TagSet(std::vector<Tag>{}) {}
+
+TagSet::TagSet(std::vector<Tag> tags) : tags_(std::move(tags)) {
+  tag_ends_.reserve(tags_.size());
+  response_body_ = kBodyBegin;
+  for (const auto& tag : tags_) {
+    if (!tag_ends_.empty()) {
+      response_body_ += ',';
+    }
+    response_body_ += userver::formats::json::ToString(
+        userver::formats::json::ValueBuilder{tag.name_}.ExtractValue());
+    tag_ends_.push_back(response_body_.size());
+  }
+  response_body_ += kBodyEnd;
+}
+
+TagSet TagSet::Apply(const std::vector<Tag>& changes) const {
+  // Changes are few next to the ranking: the changed tags are taken out of
+  // it, and the ones still in use are sorted and merged back in one pass.
+  // The last change of a tag wins.
+  std::unordered_set<std::string_view> changed_names;
+  std::vector<Tag> changed;
+  for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+    if (changed_names.insert(it->name_).second && it->articles_count_ > 0) {
+      changed.push_back(*it);
+    }
+  }
+  std::sort(changed.begin(), changed.end(), Ranks);
+
+  std::vector<Tag> tags;
+  tags.reserve(tags_.size() + changed.size());
+  auto next_changed = changed.begin();
+  for (const auto& tag : tags_) {
+    if (changed_names.count(tag.name_) != 0) {
+      continue;
+    }
+    for (; next_changed != changed.end() && Ranks(*next_changed, tag);
+         ++next_changed) {
+      tags.push_back(std::move(*next_changed));
+    }
+    tags.push_back(tag);
+  }
+  std::move(next_changed, changed.end(), std::back_inserter(tags));
+  return TagSet{std::move(tags)};
+}
+
+const std::vector<Tag>& TagSet::GetTags() const noexcept { return tags_; }
+
+const std::string& TagSet::GetResponseBody() const noexcept {
+  return response_body_;
+}
+
+std::string TagSet::GetTopResponseBody(std::size_t limit) const {
+  if (limit >= tags_.size()) {
+    return response_body_;
+  }
+  const auto size = limit == 0 ? kBodyBegin.size() : tag_ends_[limit - 1];
+  std::string body;
+  body.reserve(size + kBodyEnd.size());
+  body.append(response_body_, 0, size);
+  body += kBodyEnd;
+  return body;
+}
+
+std::size_t TagSet::GetSize() const noexcept { return tags_.size(); }
+
+}  // namespace realworld::tags
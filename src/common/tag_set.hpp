@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace realworld::tags {
+
+// Row of realworld.get_tags(), a tag is in use while articles_count > 0
+struct Tag final {
+  std::string name_;
+  std::int32_t articles_count_{0};
+};
+
+// Immutable ranking of the tags in use, most used first and then by name,
+// with the GET /api/tags body serialized once per change. The body of the
+// top N tags is a prefix of the full one, so a request with a limit copies
+// it instead of sorting or serializing anything.
+class TagSet final {
+ public:
+  TagSet();
+
+  // Copy with the changed tags applied, a full update applies every tag to
+  // an empty set
+  TagSet Apply(const std::vector<Tag>& changes) const;
+
+  const std::vector<Tag>& GetTags() const noexcept;
+
+  // Body with every tag in use
+  const std::string& GetResponseBody() const noexcept;
+
+  // Body with the `limit` most used tags
+  std::string GetTopResponseBody(std::size_t limit) const;
+
+  std::size_t GetSize() const noexcept;
+
+ private:
+  explicit TagSet(std::vector<Tag> tags);
+
+  std::vector<Tag> tags_;
+  std::string response_body_;
+  // Offset in response_body_ right after the i-th tag
+  std::vector<std::size_t> tag_ends_;
+};
+
+}  // namespace realworld::tags
@@ -0,0 +1,74 @@
+#include "tag_set.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+namespace realworld {
+
+namespace {
+
+std::vector<tags::Tag> MakeTags(std::int64_t count) {
+  std::vector<tags::Tag> tags;
+  tags.reserve(count);
+  for (std::int64_t i = 0; i < count; ++i) {
+    tags.push_back({"tag" + std::to_string(i), static_cast<std::int32_t>(i)});
+  }
+  return tags;
+}
+
+}  // namespace
+
+// The handler as it was before the cache: one row per article of a tag
+// came back from the database and was built into a JSON value per request.
+// range(0) is the number of tags, every tag is on 30 articles.
+void TagsResponseUncachedBenchmark(benchmark::State& state) {
+  std::vector<std::string> rows;
+  for (const auto& tag : MakeTags(state.range(0))) {
+    rows.insert(rows.end(), 30, tag.name_);
+  }
+  for (auto _ : state) {
+    userver::formats::json::ValueBuilder builder;
+    builder["tags"] = userver::formats::common::Type::kArray;
+    for (const auto& row : rows) {
+      builder["tags"].PushBack(row);
+    }
+    benchmark::DoNotOptimize(
+        userver::formats::json::ToString(builder.ExtractValue()));
+  }
+}
+BENCHMARK(TagsResponseUncachedBenchmark)->Range(8, 8 << 10);
+
+// The handler copies the body serialized by the last cache update
+void TagsResponseCachedBenchmark(benchmark::State& state) {
+  const auto tag_set = tags::TagSet{}.Apply(MakeTags(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::string{tag_set.GetResponseBody()});
+  }
+}
+BENCHMARK(TagsResponseCachedBenchmark)->Range(8, 8 << 10);
+
+// ?limit=20 on the cached ranking
+void TagsTopResponseBenchmark(benchmark::State& state) {
+  const auto tag_set = tags::TagSet{}.Apply(MakeTags(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tag_set.GetTopResponseBody(20));
+  }
+}
+BENCHMARK(TagsTopResponseBenchmark)->Range(8, 8 << 10);
+
+// An incremental cache update: an article with two tags was written and
+// another one lost a tag
+void TagSetApplyBenchmark(benchmark::State& state) {
+  const auto tag_set = tags::TagSet{}.Apply(MakeTags(state.range(0)));
+  const std::vector<tags::Tag> changes{
+      {"tag1", 2}, {"tag3", 4}, {"new tag", 1}};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tag_set.Apply(changes));
+  }
+}
+BENCHMARK(TagSetApplyBenchmark)->Range(8, 8 << 10);
+
+}  // namespace realworld
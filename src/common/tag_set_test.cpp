@@ -0,0 +1,65 @@
+#include "tag_set.hpp"
+#include <userver/utest/utest.hpp>
+
+namespace realworld {
+
+namespace {
+
+std::vector<std::string> GetNames(const tags::TagSet& tag_set) {
+  std::vector<std::string> names;
+  for (const auto& tag : tag_set.GetTags()) {
+    names.push_back(tag.name_);
+  }
+  return names;
+}
+
+}  // namespace
+
+UTEST(TagSet, Empty) {
+  const tags::TagSet tag_set;
+  EXPECT_EQ(tag_set.GetSize(), 0);
+  EXPECT_EQ(tag_set.GetResponseBody(), R"({"tags":[]})");
+  EXPECT_EQ(tag_set.GetTopResponseBody(10), R"({"tags":[]})");
+}
+
+UTEST(TagSet, FullUpdateRanksTagsInUse) {
+  const auto tag_set = tags::TagSet{}.Apply({{"zeta", 2},
+                                             {"unused", 0},
+                                             {"alpha", 2},
+                                             {"\"quoted\"", 5},
+                                             {"beta", 1}});
+  EXPECT_EQ(GetNames(tag_set), (std::vector<std::string>{
+                                   "\"quoted\"", "alpha", "zeta", "beta"}));
+  EXPECT_EQ(tag_set.GetResponseBody(),
+            R"({"tags":["\"quoted\"","alpha","zeta","beta"]})");
+}
+
+UTEST(TagSet, TopResponseBody) {
+  const auto tag_set =
+      tags::TagSet{}.Apply({{"alpha", 3}, {"beta", 2}, {"gamma", 1}});
+  EXPECT_EQ(tag_set.GetTopResponseBody(1), R"({"tags":["alpha"]})");
+  EXPECT_EQ(tag_set.GetTopResponseBody(2), R"({"tags":["alpha","beta"]})");
+  EXPECT_EQ(tag_set.GetTopResponseBody(3), tag_set.GetResponseBody());
+  EXPECT_EQ(tag_set.GetTopResponseBody(100), tag_set.GetResponseBody());
+}
+
+UTEST(TagSet, IncrementalUpdate) {
+  const auto before =
+      tags::TagSet{}.Apply({{"alpha", 3}, {"beta", 2}, {"gamma", 1}});
+  const auto after =
+      before.Apply({{"beta", 0}, {"gamma", 5}, {"delta", 1}, {"omega", 0}});
+  EXPECT_EQ(GetNames(after),
+            (std::vector<std::string>{"gamma", "alpha", "delta"}));
+  EXPECT_EQ(after.GetResponseBody(), R"({"tags":["gamma","alpha","delta"]})");
+  EXPECT_EQ(before.GetSize(), 3);
+}
+
+UTEST(TagSet, LastChangeOfATagWins) {
+  const auto tag_set = tags::TagSet{}.Apply(
+      {{"alpha", 1}, {"alpha", 0}, {"beta", 0}, {"beta", 4}, {"beta", 2}});
+  ASSERT_EQ(tag_set.GetSize(), 1);
+  EXPECT_EQ(tag_set.GetTags()[0].name_, "beta");
+  EXPECT_EQ(tag_set.GetTags()[0].articles_count_, 2);
+}
+
+}  // namespace realworld
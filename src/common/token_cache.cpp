@@ -0,0 +1,47 @@
+#include "token_cache.hpp"
+#include "userver/crypto/hash.hpp"
+
+namespace realworld::auth {
+
+namespace {
+
+std::string GetDigest(std::string_view token) {
+  return userver::crypto::hash::Sha256(
+      token, userver::crypto::hash::OutputEncoding::kBinary);
+}
+
+}  // namespace
+
+TokenCache::TokenCache(std::size_t ways, std::size_t way_size)
+    : cache_{ways, way_size} {}
+
+std::optional<std::int32_t> TokenCache::Get(std::string_view token) const {
+  const auto digest = GetDigest(token);
+  const auto entry = cache_.Get(digest);
+  if (!entry || entry->expires_at_ <= std::chrono::system_clock::now()) {
+    if (entry) {
+      cache_.InvalidateByKey(digest);
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return entry->user_id_;
+}
+
+void TokenCache::Put(std::string_view token, std::int32_t user_id,
+                     std::chrono::system_clock::time_point expires_at) const {
+  cache_.Put(GetDigest(token), Entry{user_id, expires_at});
+}
+
+std::size_t TokenCache::GetSize() const { return cache_.GetSize(); }
+
+std::uint64_t TokenCache::GetHits() const noexcept {
+  return hits_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TokenCache::GetMisses() const noexcept {
+  return misses_.load(std::memory_order_relaxed);
+}
+
+}  // namespace realworld::auth
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "userver/cache/nway_lru_cache.hpp"
+
+namespace realworld::auth {
+
+// Bounded cache of tokens that passed signature verification. Entries are
+// keyed by the SHA-256 digest of the raw token and are only returned until
+// the token expires, so a hit never needs to decode or verify it again.
+class TokenCache final {
+ public:
+  TokenCache(std::size_t ways, std::size_t way_size);
+
+  std::optional<std::int32_t> Get(std::string_view token) const;
+
+  void Put(std::string_view token, std::int32_t user_id,
+           std::chrono::system_clock::time_point expires_at) const;
+
+  std::size_t GetSize() const;
+  std::uint64_t GetHits() const noexcept;
+  std::uint64_t GetMisses() const noexcept;
+
+ private:
+  struct Entry final {
+    std::int32_t user_id_{};
+    std::chrono::system_clock::time_point expires_at_;
+  };
+
+  mutable userver::cache::NWayLRU<std::string, Entry> cache_;
+  mutable std::atomic<std::uint64_t> hits_{0};
+  mutable std::atomic<std::uint64_t> misses_{0};
+};
+
+}  // namespace realworld::auth
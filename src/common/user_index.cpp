@@ -0,0 +1,217 @@
+#include "user_index.hpp"
+#include <functional>
+#include <utility>
+
+namespace realworld::users {
+
+namespace {
+
+// Allocated bytes of a string, 0 while it fits the inline buffer
+std::size_t GetHeapBytes(const std::string& str) noexcept {
+  static const std::size_t kInlineCapacity = std::string{}.capacity();
+  return str.capacity() > kInlineCapacity ? str.capacity() + 1 : 0;
+}
+
+std::size_t GetHeapBytes(const std::optional<std::string>& str) noexcept {
+  return str ? GetHeapBytes(*str) : 0;
+}
+
+// Use and weak counts and a vtable pointer in front of a make_shared object
+constexpr std::size_t kControlBlockBytes{2 * sizeof(long) + sizeof(void*)};
+
+// Next pointer and cached hash of a hash map node, plus its bucket slot
+constexpr std::size_t kNodeBytes{2 * sizeof(void*) + sizeof(std::size_t)};
+
+}  // namespace
+
+std::string GetUsernameKey(std::string_view username) {
+  std::string key{username};
+  for (auto& c : key) {
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+  }
+  return key;
+}
+
+void UserIndex::insert_or_assign(std::int32_t id, models::UserRecord&& user) {
+  auto key = GetUsernameKey(user.username_);
+  auto record = std::make_shared<const models::UserRecord>(std::move(user));
+  auto& id_shard = GetMutableIdShard(id);
+  const auto it = id_shard.find(id);
+  if (it != id_shard.end()) {
+    bytes_ -= GetUserBytes(*it->second);
+    auto old_key = GetUsernameKey(it->second->username_);
+    if (old_key != key) {
+      // Unless another user of the same update took the name already
+      auto& old_shard = GetMutableUsernameShard(old_key);
+      const auto old_it = old_shard.find(old_key);
+      if (old_it != old_shard.end() && old_it->second == id) {
+        old_shard.erase(old_it);
+      }
+    }
+    it->second = record;
+  } else {
+    id_shard.emplace(id, record);
+    ++size_;
+  }
+  bytes_ += GetUserBytes(*record);
+  GetMutableUsernameShard(key).insert_or_assign(std::move(key), id);
+}
+
+std::size_t UserIndex::size() const noexcept { return size_; }
+
+UserPtr UserIndex::FindById(std::int32_t id) const {
+  const auto& shard = by_id_[static_cast<std::uint32_t>(id) % kShards];
+  if (!shard) {
+    return nullptr;
+  }
+  const auto it = shard->find(id);
+  return it == shard->end() ? nullptr : it->second;
+}
+
+UserPtr UserIndex::FindByUsername(std::string_view username) const {
+  const auto key = GetUsernameKey(username);
+  const auto& shard = by_username_[std::hash<std::string>{}(key) % kShards];
+  if (!shard) {
+    return nullptr;
+  }
+  const auto it = shard->find(key);
+  return it == shard->end() ? nullptr : FindById(it->second);
+}
+
+std::size_t UserIndex::GetBytes() const noexcept { return bytes_; }
+
+std::size_t UserIndex::GetUserBytes(const models::UserRecord& user) noexcept {
+  return sizeof(models::UserRecord) + kControlBlockBytes +
+         GetHeapBytes(user.username_) + GetHeapBytes(user.email_) +
+         GetHeapBytes(user.bio_) + GetHeapBytes(user.image_) +
+         sizeof(IdShard::value_type) + kNodeBytes +
+         sizeof(UsernameShard::value_type) + kNodeBytes +
+         GetHeapBytes(user.username_);
+}
+
+// Shards are only shared with older copies, which nothing copies again, so a
+// use count of 1 can not grow under our feet and the shard is ours to change
+UserIndex::IdShard& UserIndex::GetMutableIdShard(std::int32_t id) {
+  auto& shard = by_id_[static_cast<std::uint32_t>(id) % kShards];
+  if (!shard) {
+    shard = std::make_shared<IdShard>();
+  } else if (shard.use_count() > 1) {
+    shard = std::make_shared<IdShard>(*shard);
+  }
+  return *shard;
+}
+
+UserIndex::UsernameShard& UserIndex::GetMutableUsernameShard(
+    const std::string& key) {
+  auto& shard = by_username_[std::hash<std::string>{}(key) % kShards];
+  if (!shard) {
+    shard = std::make_shared<UsernameShard>();
+  } else if (shard.use_count() > 1) {
+    shard = std::make_shared<UsernameShard>(*shard);
+  }
+  return *shard;
+}
+
+RecentUsers::RecentUsers(std::chrono::milliseconds max_age)
+    : max_age_{max_age} {}
+
+void RecentUsers::Put(models::UserRecord user) const {
+  const auto id = user.id_;
+  auto key = GetUsernameKey(user.username_);
+  const auto now = Clock::now();
+  auto entries = entries_.StartWrite();
+  Prune(*entries, now);
+  // A rename frees the previous key unless another user has taken it since
+  const auto it = entries->by_id_.find(id);
+  if (it != entries->by_id_.end()) {
+    const auto previous = entries->by_username_.find(it->second.username_key_);
+    if (previous != entries->by_username_.end() && previous->second == id) {
+      entries->by_username_.erase(previous);
+    }
+  }
+  entries->by_username_[key] = id;
+  entries->by_id_[id] =
+      Entry{std::make_shared<const models::UserRecord>(std::move(user)),
+            std::move(key), now};
+  entries.Commit();
+  last_written_at_.store(now.time_since_epoch().count(),
+                         std::memory_order_relaxed);
+}
+
+void RecentUsers::Clear() const { entries_.Assign(Entries{}); }
+
+UserPtr RecentUsers::FindById(const UserIndex& index, std::int32_t id) const {
+  const auto now = Clock::now();
+  if (!IsQuiet(now)) {
+    const auto entries = entries_.Read();
+    if (const auto* entry = FindFresh(*entries, id, now)) {
+      return entry->user_;
+    }
+  }
+  return index.FindById(id);
+}
+
+UserPtr RecentUsers::FindByUsername(const UserIndex& index,
+                                    std::string_view username) const {
+  const auto now = Clock::now();
+  if (IsQuiet(now)) {
+    return index.FindByUsername(username);
+  }
+  const auto entries = entries_.Read();
+  const auto it = entries->by_username_.find(GetUsernameKey(username));
+  if (it != entries->by_username_.end()) {
+    if (const auto* entry = FindFresh(*entries, it->second, now)) {
+      return entry->user_;
+    }
+  }
+  auto user = index.FindByUsername(username);
+  // Renamed since the snapshot, the name matched no recent entry above
+  if (user && FindFresh(*entries, user->id_, now)) {
+    return nullptr;
+  }
+  return user;
+}
+
+std::size_t RecentUsers::GetSize() const {
+  const auto now = Clock::now();
+  const auto entries = entries_.Read();
+  std::size_t size{0};
+  for (const auto& [id, entry] : entries->by_id_) {
+    size += now - entry.written_at_ < max_age_;
+  }
+  return size;
+}
+
+bool RecentUsers::IsQuiet(Clock::time_point now) const noexcept {
+  const Clock::time_point last_written_at{
+      Clock::duration{last_written_at_.load(std::memory_order_relaxed)}};
+  return now - last_written_at >= max_age_;
+}
+
+const RecentUsers::Entry* RecentUsers::FindFresh(
+    const Entries& entries, std::int32_t id, Clock::time_point now) const {
+  const auto it = entries.by_id_.find(id);
+  if (it == entries.by_id_.end() || now - it->second.written_at_ >= max_age_) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void RecentUsers::Prune(Entries& entries, Clock::time_point now) const {
+  for (auto it = entries.by_id_.begin(); it != entries.by_id_.end();) {
+    if (now - it->second.written_at_ >= max_age_) {
+      const auto username = entries.by_username_.find(it->second.username_key_);
+      if (username != entries.by_username_.end() &&
+          username->second == it->first) {
+        entries.by_username_.erase(username);
+      }
+      it = entries.by_id_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace realworld::users
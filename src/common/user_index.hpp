@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "models/user.hpp"
+#include "userver/rcu/rcu.hpp"
+
+namespace realworld::users {
+
+using UserPtr = std::shared_ptr<const models::UserRecord>;
+
+// Username lowercased the way CITEXT compares ASCII letters. Other letters
+// are kept as is, so a lookup that differs from the stored name only in the
+// case of a non-ASCII letter misses and must be answered by the database.
+std::string GetUsernameKey(std::string_view username);
+
+// Users by id and by case-insensitive username, the container of the users
+// cache. Both indexes are split into shards held by shared pointers, so a
+// copy, which the cache makes for every incremental update, only copies the
+// shard pointers; insert_or_assign then copies the shards it changes that
+// are still shared with another copy.
+class UserIndex final {
+ public:
+  // Adds or replaces the user with this id, dropping the previous username
+  // of a renamed user
+  void insert_or_assign(std::int32_t id, models::UserRecord&& user);
+
+  std::size_t size() const noexcept;
+
+  // nullptr if there is no such user
+  UserPtr FindById(std::int32_t id) const;
+  UserPtr FindByUsername(std::string_view username) const;
+
+  // Approximate heap and index memory of the users, see GetUserBytes()
+  std::size_t GetBytes() const noexcept;
+
+  // Approximate memory one user takes in the index: the record and its
+  // strings, the shared pointer control block and a node with a bucket in
+  // each of the two hash maps
+  static std::size_t GetUserBytes(const models::UserRecord& user) noexcept;
+
+ private:
+  static constexpr std::size_t kShards{4096};
+
+  using IdShard = std::unordered_map<std::int32_t, UserPtr>;
+  using UsernameShard = std::unordered_map<std::string, std::int32_t>;
+
+  IdShard& GetMutableIdShard(std::int32_t id);
+  UsernameShard& GetMutableUsernameShard(const std::string& key);
+
+  std::array<std::shared_ptr<IdShard>, kShards> by_id_;
+  std::array<std::shared_ptr<UsernameShard>, kShards> by_username_;
+  std::size_t size_{0};
+  std::size_t bytes_{0};
+};
+
+// Users written by this process, consulted before the cache snapshot until
+// the cache has reread them: a user reads back their own changes right away,
+// not after the next incremental update. Entries are ignored after max_age,
+// from then on the snapshot is authoritative again. Lookups read an RCU
+// snapshot of the entries, indexed by id and by username key; only writes
+// copy it.
+class RecentUsers final {
+ public:
+  explicit RecentUsers(std::chrono::milliseconds max_age);
+
+  void Put(models::UserRecord user) const;
+  void Clear() const;
+
+  UserPtr FindById(const UserIndex& index, std::int32_t id) const;
+  UserPtr FindByUsername(const UserIndex& index,
+                         std::string_view username) const;
+
+  // Entries younger than max_age
+  std::size_t GetSize() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry final {
+    UserPtr user_;
+    std::string username_key_;
+    Clock::time_point written_at_;
+  };
+
+  struct Entries final {
+    std::unordered_map<std::int32_t, Entry> by_id_;
+    std::unordered_map<std::string, std::int32_t> by_username_;
+  };
+
+  // No Put for max_age, so every entry is expired
+  bool IsQuiet(Clock::time_point now) const noexcept;
+
+  // The entry of the id if it is younger than max_age
+  const Entry* FindFresh(const Entries& entries, std::int32_t id,
+                         Clock::time_point now) const;
+
+  // Drops the entries older than max_age
+  void Prune(Entries& entries, Clock::time_point now) const;
+
+  const std::chrono::milliseconds max_age_;
+  mutable userver::rcu::Variable<Entries> entries_;
+  // Time of the last Put, lets lookups skip the entries max_age after it
+  mutable std::atomic<Clock::rep> last_written_at_{0};
+};
+
+}  // namespace realworld::users
@@ -0,0 +1,140 @@
+#include "user_index.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace realworld {
+
+namespace {
+
+constexpr std::int32_t kUsers{1000000};
+
+// Half of the users have a bio and a third an image, as in the pgbench seed
+models::UserRecord MakeUser(std::int32_t id) {
+  models::UserRecord user{id, "user" + std::to_string(id),
+                          "user" + std::to_string(id) + "@example.com",
+                          std::nullopt, std::nullopt};
+  if (id % 2 == 0) {
+    user.bio_ = "bio of user " + std::to_string(id);
+  }
+  if (id % 3 == 0) {
+    user.image_ = "https://example.com/" + std::to_string(id) + ".jpg";
+  }
+  return user;
+}
+
+const users::UserIndex& GetIndex() {
+  static const auto index = [] {
+    users::UserIndex index;
+    for (std::int32_t id = 1; id <= kUsers; ++id) {
+      index.insert_or_assign(id, MakeUser(id));
+    }
+    return index;
+  }();
+  return index;
+}
+
+// The container a PostgreSQL cache uses unless told otherwise
+using PlainMap = std::unordered_map<std::int32_t, models::UserRecord>;
+
+const PlainMap& GetPlainMap() {
+  static const auto map = [] {
+    PlainMap map;
+    for (std::int32_t id = 1; id <= kUsers; ++id) {
+      map.insert_or_assign(id, MakeUser(id));
+    }
+    return map;
+  }();
+  return map;
+}
+
+}  // namespace
+
+// A full update of 1M users, bytes_per_user is the accounted memory
+void UserIndexFullUpdateBenchmark(benchmark::State& state) {
+  std::vector<models::UserRecord> rows;
+  rows.reserve(kUsers);
+  for (std::int32_t id = 1; id <= kUsers; ++id) {
+    rows.push_back(MakeUser(id));
+  }
+  std::size_t bytes{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto copies = rows;
+    state.ResumeTiming();
+    users::UserIndex index;
+    for (auto& row : copies) {
+      const auto id = row.id_;
+      index.insert_or_assign(id, std::move(row));
+    }
+    bytes = index.GetBytes();
+    benchmark::DoNotOptimize(index);
+  }
+  state.counters["bytes_per_user"] = static_cast<double>(bytes) / kUsers;
+}
+BENCHMARK(UserIndexFullUpdateBenchmark)->Unit(benchmark::kMillisecond);
+
+// An incremental update: the cache copies the snapshot and applies the
+// users changed since the previous update, range(0) of them
+void UserIndexIncrementalUpdateBenchmark(benchmark::State& state) {
+  const auto& index = GetIndex();
+  std::int32_t id{0};
+  for (auto _ : state) {
+    auto copy = index;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      id = id % kUsers + 7919;
+      copy.insert_or_assign(id % kUsers + 1, MakeUser(id % kUsers + 1));
+    }
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(UserIndexIncrementalUpdateBenchmark)
+    ->Arg(1)
+    ->Arg(100)
+    ->Unit(benchmark::kMicrosecond);
+
+// The same on the plain map, which copies every user
+void PlainMapIncrementalUpdateBenchmark(benchmark::State& state) {
+  const auto& map = GetPlainMap();
+  std::int32_t id{0};
+  for (auto _ : state) {
+    auto copy = map;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      id = id % kUsers + 7919;
+      copy.insert_or_assign(id % kUsers + 1, MakeUser(id % kUsers + 1));
+    }
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(PlainMapIncrementalUpdateBenchmark)
+    ->Arg(1)
+    ->Arg(100)
+    ->Unit(benchmark::kMicrosecond);
+
+void UserIndexFindByIdBenchmark(benchmark::State& state) {
+  const auto& index = GetIndex();
+  std::int32_t id{0};
+  for (auto _ : state) {
+    id = id % kUsers + 7919;
+    benchmark::DoNotOptimize(index.FindById(id % kUsers + 1));
+  }
+}
+BENCHMARK(UserIndexFindByIdBenchmark);
+
+// Path arguments come in any case, the key is lowercased first
+void UserIndexFindByUsernameBenchmark(benchmark::State& state) {
+  const auto& index = GetIndex();
+  std::vector<std::string> usernames;
+  for (std::int32_t id = 1; id <= 1000; ++id) {
+    usernames.push_back("User" + std::to_string(id * 997));
+  }
+  std::size_t i{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        index.FindByUsername(usernames[i++ % usernames.size()]));
+  }
+}
+BENCHMARK(UserIndexFindByUsernameBenchmark);
+
+}  // namespace realworld
@@ -0,0 +1,109 @@
+#include "user_index.hpp"
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+namespace realworld {
+
+namespace {
+
+models::UserRecord MakeUser(std::int32_t id, std::string username) {
+  return {id, std::move(username), "user" + std::to_string(id) + "@example.com",
+          std::nullopt, std::nullopt};
+}
+
+}  // namespace
+
+UTEST(UserIndex, FindByIdAndUsername) {
+  users::UserIndex index;
+  EXPECT_EQ(index.FindById(1), nullptr);
+  EXPECT_EQ(index.FindByUsername("jake"), nullptr);
+  index.insert_or_assign(1, MakeUser(1, "Jake"));
+  index.insert_or_assign(2, MakeUser(2, "Ünal"));
+
+  EXPECT_EQ(index.size(), 2);
+  EXPECT_EQ(index.FindById(1)->username_, "Jake");
+  EXPECT_EQ(index.FindByUsername("jAKE")->id_, 1);
+  EXPECT_EQ(index.FindByUsername("Ünal")->id_, 2);
+  // Left to the database
+  EXPECT_EQ(index.FindByUsername("ünal"), nullptr);
+  EXPECT_EQ(index.FindById(3), nullptr);
+}
+
+UTEST(UserIndex, Rename) {
+  users::UserIndex index;
+  index.insert_or_assign(1, MakeUser(1, "x"));
+  index.insert_or_assign(2, MakeUser(2, "z"));
+  // One update may see the name taken by another user before its owner
+  // is seen renamed
+  index.insert_or_assign(2, MakeUser(2, "X"));
+  index.insert_or_assign(1, MakeUser(1, "y"));
+
+  EXPECT_EQ(index.size(), 2);
+  EXPECT_EQ(index.FindByUsername("x")->id_, 2);
+  EXPECT_EQ(index.FindByUsername("y")->id_, 1);
+  EXPECT_EQ(index.FindByUsername("z"), nullptr);
+}
+
+UTEST(UserIndex, CopiesAreIndependent) {
+  users::UserIndex index;
+  index.insert_or_assign(1, MakeUser(1, "jake"));
+  auto copy = index;
+  copy.insert_or_assign(1, MakeUser(1, "jacob"));
+  copy.insert_or_assign(2, MakeUser(2, "jake"));
+
+  EXPECT_EQ(index.size(), 1);
+  EXPECT_EQ(index.FindByUsername("jake")->id_, 1);
+  EXPECT_EQ(index.FindByUsername("jacob"), nullptr);
+  EXPECT_EQ(copy.size(), 2);
+  EXPECT_EQ(copy.FindByUsername("jake")->id_, 2);
+  EXPECT_EQ(copy.FindByUsername("jacob")->id_, 1);
+}
+
+UTEST(UserIndex, Bytes) {
+  users::UserIndex index;
+  EXPECT_EQ(index.GetBytes(), 0);
+  auto user = MakeUser(1, "jake");
+  const auto short_bytes = users::UserIndex::GetUserBytes(user);
+  index.insert_or_assign(1, std::move(user));
+  EXPECT_EQ(index.GetBytes(), short_bytes);
+
+  user = MakeUser(1, "jake");
+  user.bio_ = std::string(1000, 'b');
+  const auto long_bytes = users::UserIndex::GetUserBytes(user);
+  EXPECT_GT(long_bytes, short_bytes + 1000);
+  index.insert_or_assign(1, std::move(user));
+  EXPECT_EQ(index.GetBytes(), long_bytes);
+}
+
+UTEST(RecentUsers, OverlayTheIndex) {
+  users::UserIndex index;
+  index.insert_or_assign(1, MakeUser(1, "jake"));
+  index.insert_or_assign(2, MakeUser(2, "anna"));
+  const users::RecentUsers recent{std::chrono::minutes{1}};
+  EXPECT_EQ(recent.FindById(index, 1)->username_, "jake");
+
+  recent.Put(MakeUser(1, "Jacob"));
+  EXPECT_EQ(recent.GetSize(), 1);
+  EXPECT_EQ(recent.FindById(index, 1)->username_, "Jacob");
+  EXPECT_EQ(recent.FindByUsername(index, "jacob")->id_, 1);
+  EXPECT_EQ(recent.FindByUsername(index, "jake"), nullptr);
+  EXPECT_EQ(recent.FindByUsername(index, "anna")->id_, 2);
+
+  recent.Clear();
+  EXPECT_EQ(recent.GetSize(), 0);
+  EXPECT_EQ(recent.FindByUsername(index, "jake")->id_, 1);
+}
+
+UTEST(RecentUsers, Expire) {
+  users::UserIndex index;
+  index.insert_or_assign(1, MakeUser(1, "jake"));
+  const users::RecentUsers recent{std::chrono::milliseconds{20}};
+  recent.Put(MakeUser(1, "jacob"));
+  EXPECT_EQ(recent.FindById(index, 1)->username_, "jacob");
+
+  userver::engine::SleepFor(std::chrono::milliseconds{30});
+  EXPECT_EQ(recent.FindById(index, 1)->username_, "jake");
+  EXPECT_EQ(recent.GetSize(), 0);
+}
+
+}  // namespace realworld
@@ -0,0 +1,372 @@
+#include "utf8.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#define REALWORLD_UTF8_X86 1
+#include <immintrin.h>
+#endif
+
+namespace realworld::utf8 {
+
+namespace {
+
+constexpr bool IsContinuation(unsigned char c) { return (c & 0xC0) == 0x80; }
+
+// Returns the length of the well-formed non-ASCII sequence starting at pos
+// or 0 if it is malformed (Unicode Standard, table 3-7).
+std::size_t DecodeMultibyte(std::string_view str, std::size_t pos) {
+  const auto* data = reinterpret_cast<const unsigned char*>(str.data());
+  const auto left = str.size() - pos;
+  const auto lead = data[pos];
+  if (lead < 0xC2) {
+    return 0;
+  }
+  if (lead < 0xE0) {
+    return left >= 2 && IsContinuation(data[pos + 1]) ? 2 : 0;
+  }
+  if (lead < 0xF0) {
+    if (left < 3) {
+      return 0;
+    }
+    const auto second = data[pos + 1];
+    const unsigned char min = lead == 0xE0 ? 0xA0 : 0x80;
+    const unsigned char max = lead == 0xED ? 0x9F : 0xBF;
+    return second >= min && second <= max && IsContinuation(data[pos + 2])
+               ? 3
+               : 0;
+  }
+  if (lead < 0xF5) {
+    if (left < 4) {
+      return 0;
+    }
+    const auto second = data[pos + 1];
+    const unsigned char min = lead == 0xF0 ? 0x90 : 0x80;
+    const unsigned char max = lead == 0xF4 ? 0x8F : 0xBF;
+    return second >= min && second <= max && IsContinuation(data[pos + 2]) &&
+                   IsContinuation(data[pos + 3])
+               ? 4
+               : 0;
+  }
+  return 0;
+}
+
+std::size_t DecodeOne(std::string_view str, std::size_t pos) {
+  return static_cast<unsigned char>(str[pos]) < 0x80
+             ? 1
+             : DecodeMultibyte(str, pos);
+}
+
+#ifdef REALWORLD_UTF8_X86
+
+constexpr std::size_t kSse2BlockSize{16};
+
+// SSE2 has no byte shuffle for the lookup tables of the AVX2 kernel, so
+// the rules of table 3-7 are checked with unsigned byte comparisons on
+// each byte and the three bytes before it.
+__m128i GreaterOrEqual(__m128i bytes, std::uint8_t value) {
+  return _mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(value)), bytes);
+}
+
+__m128i LessOrEqual(__m128i bytes, std::uint8_t value) {
+  return _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(value)), bytes);
+}
+
+__m128i Equal(__m128i bytes, std::uint8_t value) {
+  return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(value));
+}
+
+// The block shifted right by n bytes, with the end of the previous block
+// shifted in
+template <int N>
+__m128i Previous(__m128i input, __m128i prev_input) {
+  return _mm_or_si128(_mm_slli_si128(input, N),
+                      _mm_srli_si128(prev_input, 16 - N));
+}
+
+struct Sse2State final {
+  __m128i error;
+  __m128i prev_input;
+  // Two 64-bit lanes, summed at the end
+  __m128i continuations;
+};
+
+__attribute__((always_inline)) inline void ProcessBlock(Sse2State& state,
+                                                     __m128i input) {
+  // An ASCII block after an ASCII block can hold no error
+  if (_mm_movemask_epi8(_mm_or_si128(input, state.prev_input)) == 0) {
+    state.prev_input = input;
+    return;
+  }
+  // As signed bytes continuations are exactly the values below -64. Every
+  // other byte starts a code point.
+  const auto is_continuation = _mm_cmplt_epi8(input, _mm_set1_epi8(-64));
+  state.continuations = _mm_add_epi64(
+      state.continuations,
+      _mm_sad_epu8(_mm_and_si128(is_continuation, _mm_set1_epi8(1)),
+                   _mm_setzero_si128()));
+  const auto prev1 = Previous<1>(input, state.prev_input);
+  const auto prev2 = Previous<2>(input, state.prev_input);
+  const auto prev3 = Previous<3>(input, state.prev_input);
+
+  // A byte must be a continuation exactly when it is the second byte of a
+  // sequence, the third of a 3- or 4-byte one or the fourth of a 4-byte one
+  const auto must_be_continuation =
+      _mm_or_si128(_mm_or_si128(GreaterOrEqual(prev1, 0xC0),
+                                GreaterOrEqual(prev2, 0xE0)),
+                   GreaterOrEqual(prev3, 0xF0));
+  auto error = _mm_xor_si128(is_continuation, must_be_continuation);
+
+  // Bytes that never appear: C0 and C1 would be overlong, F5 and above too
+  // large
+  error = _mm_or_si128(error, _mm_and_si128(GreaterOrEqual(input, 0xC0),
+                                            LessOrEqual(input, 0xC1)));
+  error = _mm_or_si128(error, GreaterOrEqual(input, 0xF5));
+
+  // Second bytes narrower than 80..BF: overlong 3- and 4-byte forms,
+  // surrogates and code points above U+10FFFF
+  error = _mm_or_si128(error, _mm_andnot_si128(GreaterOrEqual(input, 0xA0),
+                                               Equal(prev1, 0xE0)));
+  error = _mm_or_si128(error, _mm_andnot_si128(LessOrEqual(input, 0x9F),
+                                               Equal(prev1, 0xED)));
+  error = _mm_or_si128(error, _mm_andnot_si128(GreaterOrEqual(input, 0x90),
+                                               Equal(prev1, 0xF0)));
+  error = _mm_or_si128(error, _mm_andnot_si128(LessOrEqual(input, 0x8F),
+                                               Equal(prev1, 0xF4)));
+
+  state.error = _mm_or_si128(state.error, error);
+  state.prev_input = input;
+}
+
+#define REALWORLD_AVX2 __attribute__((target("avx2,popcnt")))
+
+constexpr std::size_t kAvx2BlockSize{32};
+
+// Error classes of two consecutive bytes, see the paper for the derivation.
+constexpr std::uint8_t kTooShort{1 << 0};
+constexpr std::uint8_t kTooLong{1 << 1};
+constexpr std::uint8_t kOverlong3{1 << 2};
+constexpr std::uint8_t kTooLarge{1 << 3};
+constexpr std::uint8_t kSurrogate{1 << 4};
+constexpr std::uint8_t kOverlong2{1 << 5};
+constexpr std::uint8_t kTooLarge1000{1 << 6};
+constexpr std::uint8_t kOverlong4{1 << 6};
+constexpr std::uint8_t kTwoConts{1 << 7};
+constexpr std::uint8_t kCarry{kTooShort | kTooLong | kTwoConts};
+
+// Indexed by the high nibble of the previous byte
+constexpr std::array<std::uint8_t, 16> kByte1High{
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTwoConts,
+    kTwoConts,
+    kTwoConts,
+    kTwoConts,
+    kTooShort | kOverlong2,
+    kTooShort,
+    kTooShort | kOverlong3 | kSurrogate,
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+};
+
+// Indexed by the low nibble of the previous byte
+constexpr std::array<std::uint8_t, 16> kByte1Low{
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+};
+
+// Indexed by the high nibble of the current byte
+constexpr std::array<std::uint8_t, 16> kByte2High{
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+};
+
+REALWORLD_AVX2 __m256i LoadTable(const std::array<std::uint8_t, 16>& table) {
+  return _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.data())));
+}
+
+struct Avx2State final {
+  __m256i byte_1_high;
+  __m256i byte_1_low;
+  __m256i byte_2_high;
+  __m256i error;
+  __m256i prev_input;
+  std::size_t count;
+};
+
+REALWORLD_AVX2 void ProcessBlock(Avx2State& state, __m256i input) {
+  const auto low_nibble_mask = _mm256_set1_epi8(0x0F);
+  // The last 16 bytes of the previous block followed by the first 16 bytes
+  // of the current one, so that alignr can shift across the lane boundary.
+  const auto shifted =
+      _mm256_permute2x128_si256(state.prev_input, input, 0x21);
+  const auto prev1 = _mm256_alignr_epi8(input, shifted, 15);
+  const auto prev2 = _mm256_alignr_epi8(input, shifted, 14);
+  const auto prev3 = _mm256_alignr_epi8(input, shifted, 13);
+
+  const auto byte_1_high = _mm256_shuffle_epi8(
+      state.byte_1_high,
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble_mask));
+  const auto byte_1_low = _mm256_shuffle_epi8(
+      state.byte_1_low, _mm256_and_si256(prev1, low_nibble_mask));
+  const auto byte_2_high = _mm256_shuffle_epi8(
+      state.byte_2_high,
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble_mask));
+  const auto special_cases =
+      _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+  // Third and fourth bytes of 3- and 4-byte sequences must be continuations;
+  // that is the only case when two continuations in a row are fine.
+  const auto is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0x60));
+  const auto is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0x70));
+  const auto must_be_continuation =
+      _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                       _mm256_set1_epi8(static_cast<char>(0x80)));
+  state.error = _mm256_or_si256(
+      state.error, _mm256_xor_si256(must_be_continuation, special_cases));
+
+  // Every byte except continuations starts a code point. As signed bytes
+  // continuations are exactly the values below -64.
+  const auto starts_code_point = _mm256_cmpgt_epi8(input, _mm256_set1_epi8(-65));
+  state.count += static_cast<std::size_t>(
+      _mm_popcnt_u32(static_cast<std::uint32_t>(
+          _mm256_movemask_epi8(starts_code_point))));
+  state.prev_input = input;
+}
+
+#endif
+
+}  // namespace
+
+namespace impl {
+
+std::optional<std::size_t> CountCodePointsScalar(std::string_view str) {
+  std::size_t count{0};
+  std::size_t pos{0};
+  while (pos < str.size()) {
+    const auto length = DecodeOne(str, pos);
+    if (length == 0) {
+      return std::nullopt;
+    }
+    pos += length;
+    ++count;
+  }
+  return count;
+}
+
+#ifdef REALWORLD_UTF8_X86
+
+std::optional<std::size_t> CountCodePointsSse2(std::string_view str) {
+  Sse2State state{_mm_setzero_si128(), _mm_setzero_si128(),
+                  _mm_setzero_si128()};
+  std::size_t pos{0};
+  for (; str.size() - pos >= kSse2BlockSize; pos += kSse2BlockSize) {
+    ProcessBlock(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                            str.data() + pos)));
+  }
+  // Zero padding, as in CountCodePointsAvx2. Zeros are not continuations
+  // and add nothing to the count.
+  alignas(kSse2BlockSize) char tail[kSse2BlockSize]{};
+  std::memcpy(tail, str.data() + pos, str.size() - pos);
+  ProcessBlock(state, _mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+
+  if (_mm_movemask_epi8(state.error) != 0) {
+    return std::nullopt;
+  }
+  alignas(kSse2BlockSize) std::uint64_t continuations[2];
+  _mm_store_si128(reinterpret_cast<__m128i*>(continuations),
+                  state.continuations);
+  return str.size() - continuations[0] - continuations[1];
+}
+
+REALWORLD_AVX2 std::optional<std::size_t> CountCodePointsAvx2(
+    std::string_view str) {
+  Avx2State state{LoadTable(kByte1High),  LoadTable(kByte1Low),
+                  LoadTable(kByte2High),  _mm256_setzero_si256(),
+                  _mm256_setzero_si256(), 0};
+  std::size_t pos{0};
+  for (; str.size() - pos >= kAvx2BlockSize; pos += kAvx2BlockSize) {
+    ProcessBlock(state, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+                            str.data() + pos)));
+  }
+  // The tail is padded with zeros, which are ASCII: a sequence truncated by
+  // the end of the string is reported like one interrupted by an ASCII
+  // character. The block is processed even if the tail is empty to check
+  // the end of the previous block.
+  alignas(kAvx2BlockSize) char tail[kAvx2BlockSize]{};
+  const auto tail_size = str.size() - pos;
+  std::memcpy(tail, str.data() + pos, tail_size);
+  ProcessBlock(state,
+               _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+
+  if (!_mm256_testz_si256(state.error, state.error)) {
+    return std::nullopt;
+  }
+  return state.count - (kAvx2BlockSize - tail_size);
+}
+
+bool HasAvx2() noexcept {
+  static const bool kHasAvx2 = __builtin_cpu_supports("avx2") &&
+                               __builtin_cpu_supports("popcnt");
+  return kHasAvx2;
+}
+
+#else
+
+std::optional<std::size_t> CountCodePointsSse2(std::string_view str) {
+  return CountCodePointsScalar(str);
+}
+
+std::optional<std::size_t> CountCodePointsAvx2(std::string_view str) {
+  return CountCodePointsScalar(str);
+}
+
+bool HasAvx2() noexcept { return false; }
+
+#endif
+
+}  // namespace impl
+
+std::optional<std::size_t> CountCodePoints(std::string_view str) {
+  if (impl::HasAvx2()) {
+    return impl::CountCodePointsAvx2(str);
+  }
+  return impl::CountCodePointsSse2(str);
+}
+
+}  // namespace realworld::utf8
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace realworld::utf8 {
+
+// Validates UTF-8 and counts its code points in one pass without
+// allocating. Returns std::nullopt if the string is not well-formed UTF-8
+// (overlong forms, surrogates, code points above U+10FFFF and truncated
+// sequences are all rejected).
+std::optional<std::size_t> CountCodePoints(std::string_view str);
+
+namespace impl {
+
+std::optional<std::size_t> CountCodePointsScalar(std::string_view str);
+
+// Validates and counts 16 bytes at a time with SSE2 comparisons, skipping
+// runs of ASCII blocks. Same as the scalar version on non-x86 targets.
+std::optional<std::size_t> CountCodePointsSse2(std::string_view str);
+
+// Fully vectorized validation with the lookup tables of Keiser and Lemire
+// ("Validating UTF-8 In Less Than One Instruction Per Byte"). Must only be
+// called if HasAvx2() is true.
+std::optional<std::size_t> CountCodePointsAvx2(std::string_view str);
+
+bool HasAvx2() noexcept;
+
+}  // namespace impl
+
+}  // namespace realworld::utf8
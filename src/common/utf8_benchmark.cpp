@@ -0,0 +1,74 @@
+#include "utf8.hpp"
+#include <benchmark/benchmark.h>
+#include "unicode/unistr.h"
+
+namespace realworld {
+
+namespace {
+
+// Article body sized inputs: the longest allowed body is 65535 code points
+std::string MakeBody(std::int64_t kind) {
+  static constexpr std::string_view kParagraphs[]{
+      "The quick brown fox jumps over the lazy dog. ",
+      "Съешь же ещё этих мягких французских булок, да выпей чаю. ",
+      "敏捷的棕色狐狸跳过了懒狗。",
+  };
+  const auto paragraph = kParagraphs[kind];
+  std::string body;
+  while (body.size() + paragraph.size() <= 65535) {
+    body += paragraph;
+  }
+  return body;
+}
+
+void SetLabel(benchmark::State& state, const std::string& body) {
+  static constexpr std::string_view kLabels[]{"ascii", "cyrillic", "cjk"};
+  state.SetLabel(std::string{kLabels[state.range(0)]});
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(body.size()));
+}
+
+}  // namespace
+
+void CountCodePointsIcuBenchmark(benchmark::State& state) {
+  const auto body = MakeBody(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        icu::UnicodeString::fromUTF8(body).countChar32(0));
+  }
+  SetLabel(state, body);
+}
+BENCHMARK(CountCodePointsIcuBenchmark)->DenseRange(0, 2);
+
+void CountCodePointsScalarBenchmark(benchmark::State& state) {
+  const auto body = MakeBody(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utf8::impl::CountCodePointsScalar(body));
+  }
+  SetLabel(state, body);
+}
+BENCHMARK(CountCodePointsScalarBenchmark)->DenseRange(0, 2);
+
+void CountCodePointsSse2Benchmark(benchmark::State& state) {
+  const auto body = MakeBody(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utf8::impl::CountCodePointsSse2(body));
+  }
+  SetLabel(state, body);
+}
+BENCHMARK(CountCodePointsSse2Benchmark)->DenseRange(0, 2);
+
+void CountCodePointsAvx2Benchmark(benchmark::State& state) {
+  if (!utf8::impl::HasAvx2()) {
+    state.SkipWithError("AVX2 is not supported");
+    return;
+  }
+  const auto body = MakeBody(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utf8::impl::CountCodePointsAvx2(body));
+  }
+  SetLabel(state, body);
+}
+BENCHMARK(CountCodePointsAvx2Benchmark)->DenseRange(0, 2);
+
+}  // namespace realworld
@@ -0,0 +1,125 @@
+#include "utf8.hpp"
+#include <random>
+#include <userver/utest/utest.hpp>
+#include "unicode/unistr.h"
+#include "unicode/ustring.h"
+
+namespace realworld {
+
+namespace {
+
+std::optional<std::size_t> CountCodePointsIcu(const std::string& str) {
+  // u_strFromUTF8 fails on malformed input instead of substituting U+FFFD
+  UErrorCode status{U_ZERO_ERROR};
+  std::int32_t length{0};
+  u_strFromUTF8(nullptr, 0, &length, str.data(),
+                static_cast<std::int32_t>(str.size()), &status);
+  if (status != U_BUFFER_OVERFLOW_ERROR && U_FAILURE(status)) {
+    return std::nullopt;
+  }
+  return icu::UnicodeString::fromUTF8(str).countChar32();
+}
+
+void AppendCodePoint(std::string& str, UChar32 code_point) {
+  icu::UnicodeString{code_point}.toUTF8String(str);
+}
+
+std::string MakeRandomUtf8(std::mt19937& rng, std::size_t code_points) {
+  std::string str;
+  for (std::size_t i = 0; i < code_points; ++i) {
+    switch (rng() % 4) {
+      case 0:
+        AppendCodePoint(str, static_cast<UChar32>(rng() % 0x80));
+        break;
+      case 1:
+        AppendCodePoint(str, static_cast<UChar32>(0x80 + rng() % 0x780));
+        break;
+      case 2: {
+        auto code_point = static_cast<UChar32>(0x800 + rng() % 0xF800);
+        if (U_IS_SURROGATE(code_point)) {
+          code_point = 0xFFFD;
+        }
+        AppendCodePoint(str, code_point);
+        break;
+      }
+      default:
+        AppendCodePoint(str, static_cast<UChar32>(0x10000 + rng() % 0x100000));
+    }
+  }
+  return str;
+}
+
+void CheckAllImplementations(const std::string& str) {
+  const auto expected = CountCodePointsIcu(str);
+  ASSERT_EQ(utf8::impl::CountCodePointsScalar(str), expected) << str;
+  ASSERT_EQ(utf8::impl::CountCodePointsSse2(str), expected) << str;
+  if (utf8::impl::HasAvx2()) {
+    ASSERT_EQ(utf8::impl::CountCodePointsAvx2(str), expected) << str;
+  }
+  ASSERT_EQ(utf8::CountCodePoints(str), expected) << str;
+}
+
+}  // namespace
+
+UTEST(Utf8, CountCodePoints) {
+  EXPECT_EQ(utf8::CountCodePoints(""), 0);
+  EXPECT_EQ(utf8::CountCodePoints("hello"), 5);
+  EXPECT_EQ(utf8::CountCodePoints("привет"), 6);
+  EXPECT_EQ(utf8::CountCodePoints("你好, 世界"), 6);
+  EXPECT_EQ(utf8::CountCodePoints("\xF0\x9F\x98\x80"), 1);
+}
+
+UTEST(Utf8, Malformed) {
+  EXPECT_FALSE(utf8::CountCodePoints("\x80"));
+  EXPECT_FALSE(utf8::CountCodePoints("\xC0\xAF"));          // overlong
+  EXPECT_FALSE(utf8::CountCodePoints("\xED\xA0\x80"));      // surrogate
+  EXPECT_FALSE(utf8::CountCodePoints("\xF4\x90\x80\x80"));  // > U+10FFFF
+  EXPECT_FALSE(utf8::CountCodePoints("\xE2\x82"));          // truncated
+  EXPECT_FALSE(utf8::CountCodePoints("\xFF"));
+}
+
+UTEST(Utf8, AllTwoByteSequences) {
+  for (int first = 0; first < 256; ++first) {
+    for (int second = 0; second < 256; ++second) {
+      const std::string str{static_cast<char>(first), static_cast<char>(second)};
+      CheckAllImplementations(str);
+      // The same pair across a 16- and a 32-byte block boundary
+      CheckAllImplementations(std::string(15, 'a') + str);
+      CheckAllImplementations(std::string(31, 'a') + str);
+    }
+  }
+}
+
+UTEST(Utf8, RandomValidMatchesIcu) {
+  std::mt19937 rng{42};
+  for (int i = 0; i < 2000; ++i) {
+    CheckAllImplementations(MakeRandomUtf8(rng, rng() % 200));
+  }
+}
+
+UTEST(Utf8, RandomCorruptedMatchesIcu) {
+  std::mt19937 rng{42};
+  for (int i = 0; i < 20000; ++i) {
+    auto str = MakeRandomUtf8(rng, 1 + rng() % 100);
+    const auto mutations = 1 + rng() % 3;
+    for (std::size_t j = 0; j < mutations; ++j) {
+      auto& c = str[rng() % str.size()];
+      switch (rng() % 3) {
+        case 0:
+          c = static_cast<char>(rng());
+          break;
+        case 1:
+          c ^= static_cast<char>(1 << (rng() % 8));
+          break;
+        default:
+          str.resize(rng() % str.size());
+          if (str.empty()) {
+            str = "\xC3";
+          }
+      }
+    }
+    CheckAllImplementations(str);
+  }
+}
+
+}  // namespace realworld
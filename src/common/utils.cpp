@@ -1,47 +1,78 @@
 #include "utils.hpp"
-#include <regex>
 #include "errors.hpp"
 #include "fmt/core.h"
-#include "unicode/translit.h"
+#include "userver/http/content_type.hpp"
+#include "utf8.hpp"
 
 namespace realworld::utils {
 
-const std::string ValidateEmail(const userver::formats::json::Value& data,
-                                std::string_view name) {
-  if (!data.HasMember(name)) {
-    throw errors::ValidationError{errors::ErrorBuilder{name, "required"}};
-  }
-  const auto& email = data[name].As<std::string>();
+void CheckEmail(std::string_view email, std::string_view name) {
   if (email.empty()) {
     throw errors::ValidationError{
         errors::ErrorBuilder{name, "cannot be empty"}};
   }
-  const std::regex pattern{"(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+"};
-  if (std::regex_match(email, pattern)) {
-    return email;
+  if (!impl::IsEmail(email)) {
+    throw errors::ValidationError{errors::ErrorBuilder{name, "invalid"}};
   }
-  throw errors::ValidationError{errors::ErrorBuilder{name, "invalid"}};
 }
 
-const std::string CheckSize(const std::string& value, std::string_view name,
-                            int min, int max) {
-  const auto length = icu::UnicodeString::fromUTF8(value).countChar32(0);
-  if (length > min && length < max) {
-    return value;
+void CheckRequired(bool is_present, std::string_view name) {
+  if (!is_present) {
+    throw errors::ValidationError{errors::ErrorBuilder{name, "required"}};
   }
-  throw errors::ValidationError{
-      errors::ErrorBuilder{name, fmt::format("must be longer than {} characters"
-                                             " and less than {}",
-                                             min, max)}};
 }
 
-const std::string CheckSize(const userver::formats::json::Value& data,
-                            std::string_view name, int min, int max) {
-  if (!data.HasMember(name)) {
-    throw errors::ValidationError{errors::ErrorBuilder{name, "required"}};
+void CheckLength(std::string_view value, std::string_view name, int min,
+                 int max) {
+  const auto length = utf8::CountCodePoints(value);
+  if (!length) {
+    throw errors::ValidationError{
+        errors::ErrorBuilder{name, "must be a valid UTF-8 string"}};
+  }
+  if (*length <= static_cast<std::size_t>(min) ||
+      *length >= static_cast<std::size_t>(max)) {
+    throw errors::ValidationError{errors::ErrorBuilder{
+        name, fmt::format("must be longer than {} characters"
+                          " and less than {}",
+                          min, max)}};
+  }
+}
+
+std::string ReadString(json::Reader& reader, std::string_view name) {
+  if (reader.Peek() != json::Reader::Type::kString) {
+    throw errors::ValidationError{
+        errors::ErrorBuilder{name, "must be a string"}};
   }
-  const auto& str = data[name].As<std::string>();
-  return CheckSize(str, name, min, max);
+  return reader.ReadString();
+}
+
+std::optional<std::string> ReadOptionalString(json::Reader& reader,
+                                              std::string_view name) {
+  if (reader.SkipNull()) {
+    return std::nullopt;
+  }
+  return ReadString(reader, name);
+}
+
+std::optional<std::vector<std::string>> ReadOptionalStringArray(
+    json::Reader& reader, std::string_view name) {
+  if (reader.SkipNull()) {
+    return std::nullopt;
+  }
+  if (reader.Peek() != json::Reader::Type::kArray) {
+    throw errors::ValidationError{
+        errors::ErrorBuilder{name, "must be an array of strings"}};
+  }
+  std::vector<std::string> result;
+  reader.ReadArray([&reader, &name, &result] {
+    result.push_back(ReadString(reader, name));
+  });
+  return result;
+}
+
+void SetJsonContentType(const userver::server::http::HttpRequest& request) {
+  request.GetHttpResponse().SetContentType(
+      userver::http::content_type::kApplicationJson);
 }
 
 }  // namespace realworld::utils
\ No newline at end of file
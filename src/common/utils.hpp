@@ -2,22 +2,135 @@
 
 #include <boost/lexical_cast.hpp>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <userver/formats/parse/common_containers.hpp>
 #include "errors.hpp"
+#include "json_reader.hpp"
 #include "unicode/translit.h"
 #include "userver/formats/json/value.hpp"
 #include "userver/server/http/http_request.hpp"
 
 namespace realworld::utils {
 
-const std::string ValidateEmail(const userver::formats::json::Value& data,
-                                std::string_view email);
+namespace impl {
 
-const std::string CheckSize(const std::string& value, std::string_view name,
-                            int min, int max);
+constexpr bool IsWordChar(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
 
-const std::string CheckSize(const userver::formats::json::Value& data,
-                            const std::string_view name, int min, int max);
+// Hand-written equivalent of std::regex_match against the former pattern
+// (\w+)(\.|_)?(\w*)@(\w+)(\.(\w+))+ . Since '_' is a word character,
+// the local part is one or more word characters optionally followed by a
+// single '.' and any number of word characters. The domain is at least two
+// non-empty labels of word characters separated by single dots.
+constexpr bool IsEmail(std::string_view str) {
+  std::size_t pos{0};
+  const auto skip_word = [&str, &pos] {
+    const auto start = pos;
+    while (pos < str.size() && IsWordChar(str[pos])) {
+      ++pos;
+    }
+    return pos - start;
+  };
+
+  if (skip_word() == 0) {
+    return false;
+  }
+  if (pos < str.size() && str[pos] == '.') {
+    ++pos;
+    skip_word();
+  }
+  if (pos == str.size() || str[pos] != '@') {
+    return false;
+  }
+  ++pos;
+
+  std::size_t labels{0};
+  while (true) {
+    if (skip_word() == 0) {
+      return false;
+    }
+    ++labels;
+    if (pos == str.size()) {
+      return labels > 1;
+    }
+    if (str[pos] != '.') {
+      return false;
+    }
+    ++pos;
+  }
+}
+
+static_assert(IsEmail("jake@jake.jake"));
+static_assert(IsEmail("first.last@mail.example.com"));
+static_assert(IsEmail("first_last@mail.com"));
+static_assert(IsEmail("first.@mail.com"));
+static_assert(!IsEmail("first..last@mail.com"));
+static_assert(!IsEmail("jake@jake"));
+static_assert(!IsEmail("jake@jake..jake"));
+static_assert(!IsEmail("jake@jake.jake."));
+static_assert(!IsEmail(".jake@jake.jake"));
+static_assert(!IsEmail("jake@@jake.jake"));
+
+}  // namespace impl
+
+// Checks of the values the request parsers have read
+void CheckEmail(std::string_view email, std::string_view name);
+void CheckRequired(bool is_present, std::string_view name);
+void CheckLength(std::string_view value, std::string_view name, int min,
+                 int max);
+
+// Readers of member values for the request parsers. A value of another type
+// is reported as a ValidationError for the member, null is read as
+// std::nullopt by the optional versions.
+std::string ReadString(json::Reader& reader, std::string_view name);
+std::optional<std::string> ReadOptionalString(json::Reader& reader,
+                                              std::string_view name);
+std::optional<std::vector<std::string>> ReadOptionalStringArray(
+    json::Reader& reader, std::string_view name);
+
+// Reads a {"<root>": {...}} request body, calling on_member(reader, key)
+// for every member of the root object; on_member must consume the value.
+// Other members of the body are skipped, an empty body is read as {}.
+template <typename OnMember>
+void ReadRequestObject(std::string_view body, std::string_view root,
+                       OnMember&& on_member) {
+  try {
+    json::Reader reader{body};
+    if (reader.IsEnd()) {
+      return;
+    }
+    if (reader.Peek() != json::Reader::Type::kObject) {
+      throw errors::MalformedRequestError{
+          errors::ErrorBuilder{"body", "must be an object"}};
+    }
+    reader.ReadObject([&](std::string_view key) {
+      if (key != root) {
+        reader.Skip();
+      } else if (reader.Peek() == json::Reader::Type::kObject) {
+        reader.ReadObject(
+            [&](std::string_view member) { on_member(reader, member); });
+      } else if (!reader.SkipNull()) {
+        throw errors::ValidationError{
+            errors::ErrorBuilder{root, "must be an object"}};
+      }
+    });
+    reader.Finish();
+  } catch (const json::ParseError& ex) {
+    throw errors::MalformedRequestError{
+        errors::ErrorBuilder{"body", ex.what()}};
+  }
+}
+
+// What HttpHandlerJsonBase sends for an empty formats::json::Value
+inline constexpr std::string_view kNullJson{"null"};
+
+// Handlers that write their JSON responses themselves derive from
+// HttpHandlerBase, this sets the content type HttpHandlerJsonBase would.
+void SetJsonContentType(const userver::server::http::HttpRequest& request);
 
 }  // namespace realworld::utils
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <regex>
+
+namespace realworld {
+
+namespace {
+
+const std::string kEmail{"first.last@mail.example.com"};
+
+}  // namespace
+
+void ValidateEmailRegexBenchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    const std::regex pattern{"(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+"};
+    benchmark::DoNotOptimize(std::regex_match(kEmail, pattern));
+  }
+}
+BENCHMARK(ValidateEmailRegexBenchmark);
+
+void ValidateEmailBenchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::impl::IsEmail(kEmail));
+  }
+}
+BENCHMARK(ValidateEmailBenchmark);
+
+}  // namespace realworld
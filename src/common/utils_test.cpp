@@ -0,0 +1,47 @@
+#include "utils.hpp"
+#include <random>
+#include <regex>
+#include <userver/utest/utest.hpp>
+
+namespace realworld {
+
+namespace {
+
+const std::regex kEmailPattern{"(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+"};
+
+}  // namespace
+
+UTEST(ValidateEmail, MatchesRegexExhaustive) {
+  // Every string of up to 6 characters over the alphabet
+  constexpr std::string_view kAlphabet{"a_.@-"};
+  std::vector<std::string> level{""};
+  for (int length = 1; length <= 6; ++length) {
+    std::vector<std::string> next;
+    next.reserve(level.size() * kAlphabet.size());
+    for (const auto& prefix : level) {
+      for (const auto c : kAlphabet) {
+        next.push_back(prefix + c);
+        const auto& str = next.back();
+        ASSERT_EQ(utils::impl::IsEmail(str),
+                  std::regex_match(str, kEmailPattern))
+            << str;
+      }
+    }
+    level = std::move(next);
+  }
+}
+
+UTEST(ValidateEmail, MatchesRegexRandom) {
+  constexpr std::string_view kAlphabet{"aZ9_.@-+ \xd0"};
+  std::mt19937 rng{42};
+  for (int i = 0; i < 20000; ++i) {
+    std::string str(rng() % 24, ' ');
+    for (auto& c : str) {
+      c = kAlphabet[rng() % kAlphabet.size()];
+    }
+    ASSERT_EQ(utils::impl::IsEmail(str), std::regex_match(str, kEmailPattern))
+        << str;
+  }
+}
+
+}  // namespace realworld
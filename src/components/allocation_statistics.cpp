@@ -0,0 +1,58 @@
+#include "allocation_statistics.hpp"
+#include "userver/components/statistics_storage.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+void AllocationStatistics::Endpoint::Account(
+    const allocations::Counters& counters) const noexcept {
+  requests_.fetch_add(1, std::memory_order_relaxed);
+  allocations_.fetch_add(counters.count_, std::memory_order_relaxed);
+  bytes_.fetch_add(counters.bytes_, std::memory_order_relaxed);
+}
+
+AllocationStatistics::AllocationStatistics(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context) {
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.allocations",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+}
+
+AllocationStatistics::~AllocationStatistics() {
+  statistics_holder_.Unregister();
+}
+
+const AllocationStatistics::Endpoint& AllocationStatistics::GetEndpoint(
+    std::string_view name) {
+  auto endpoints = endpoints_.Lock();
+  return endpoints->try_emplace(std::string{name}).first->second;
+}
+
+void AllocationStatistics::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  const auto endpoints = endpoints_.Lock();
+  for (const auto& [name, endpoint] : *endpoints) {
+    auto endpoint_writer = writer[name];
+    endpoint_writer["requests"] = endpoint.requests_.load();
+    endpoint_writer["allocations"] = endpoint.allocations_.load();
+    endpoint_writer["allocated-bytes"] = endpoint.bytes_.load();
+  }
+}
+
+userver::yaml_config::Schema AllocationStatistics::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Heap allocations of response building, per endpoint
+additionalProperties: false
+properties: {}
+)");
+}
+
+}  // namespace realworld::components
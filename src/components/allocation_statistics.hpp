@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include "common/allocations.hpp"
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/loggable_component_base.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/concurrent/variable.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Heap allocations made while decoding result sets and serializing
+// responses, per endpoint. Handlers get their endpoint once and account
+// every request to it.
+class AllocationStatistics final
+    : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName{"allocation-statistics"};
+
+  class Endpoint final {
+   public:
+    void Account(const allocations::Counters& counters) const noexcept;
+
+   private:
+    friend class AllocationStatistics;
+
+    mutable std::atomic<std::uint64_t> requests_{0};
+    mutable std::atomic<std::uint64_t> allocations_{0};
+    mutable std::atomic<std::uint64_t> bytes_{0};
+  };
+
+  AllocationStatistics(const userver::components::ComponentConfig& config,
+                       const userver::components::ComponentContext& context);
+
+  ~AllocationStatistics() override;
+
+  // Valid for the lifetime of the component
+  const Endpoint& GetEndpoint(std::string_view name);
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  // A map, so that endpoints stay in place as others are added
+  mutable userver::concurrent::Variable<
+      std::map<std::string, Endpoint, std::less<>>>
+      endpoints_;
+  userver::utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool
+    kHasValidate<realworld::components::AllocationStatistics> = true;
+
+}  // namespace userver::components
@@ -0,0 +1,74 @@
+#include "article_cache.hpp"
+#include <chrono>
+#include <cstdint>
+#include "userver/components/statistics_storage.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+ArticleCache::ArticleCache(const userver::components::ComponentConfig& config,
+                           const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      cache_(config["ways"].As<std::size_t>(),
+             config["way_size"].As<std::size_t>(),
+             config["max-age"].As<std::chrono::milliseconds>()) {
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.article-cache",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+  reset_registration_ = userver::testsuite::RegisterCache(
+      config, context, this, &ArticleCache::ResetCache);
+}
+
+ArticleCache::~ArticleCache() { statistics_holder_.Unregister(); }
+
+const articles::ArticleCache& ArticleCache::GetCache() const { return cache_; }
+
+void ArticleCache::ResetCache() { cache_.InvalidateAll(); }
+
+void ArticleCache::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  const auto hits = cache_.GetHits();
+  const auto misses = cache_.GetMisses();
+  writer["size"] = cache_.GetSize();
+  writer["hits"] = hits;
+  writer["misses"] = misses;
+  writer["expired"] = cache_.GetExpired();
+  writer["invalidations"] = cache_.GetInvalidations();
+  writer["rejected-puts"] = cache_.GetRejectedPuts();
+  // Since the start, rate() of hits and misses gives the current ratio
+  writer["hit-ratio"] =
+      hits + misses == 0 ? 0.0
+                         : static_cast<double>(hits) /
+                               static_cast<double>(hits + misses);
+  // How stale the served articles are on average, at most max-age
+  const auto hit_age_sum = cache_.GetHitAgeSum().count();
+  writer["hit-age-ms"] =
+      hits == 0 ? 0 : hit_age_sum / static_cast<std::int64_t>(hits);
+}
+
+userver::yaml_config::Schema ArticleCache::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Articles by slug without the columns that depend on the viewer
+additionalProperties: false
+properties:
+    ways:
+        type: integer
+        description: number of independently locked cache shards
+        minimum: 1
+    way_size:
+        type: integer
+        description: max number of articles in each shard
+        minimum: 1
+    max-age:
+        type: string
+        description: how long an article is served from the cache at most
+)");
+}
+
+}  // namespace realworld::components
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string_view>
+#include "common/article_cache.hpp"
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/loggable_component_base.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/testsuite/cache_control.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Articles by slug for GET /api/articles/:slug, kept up to date by the
+// article write handlers of this process
+class ArticleCache final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName{"article-cache"};
+
+  ArticleCache(const userver::components::ComponentConfig& config,
+               const userver::components::ComponentContext& context);
+
+  ~ArticleCache() override;
+
+  const articles::ArticleCache& GetCache() const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  // Testsuite clears the cache between tests, as it does the other caches
+  void ResetCache();
+
+  const articles::ArticleCache cache_;
+  userver::utils::statistics::Entry statistics_holder_;
+  userver::testsuite::CacheResetRegistration reset_registration_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool kHasValidate<realworld::components::ArticleCache> = true;
+
+}  // namespace userver::components
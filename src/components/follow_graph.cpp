@@ -0,0 +1,267 @@
+#include "follow_graph.hpp"
+#include <algorithm>
+#include <utility>
+#include "db/sql.hpp"
+#include "userver/components/statistics_storage.hpp"
+#include "userver/storages/postgres/cluster.hpp"
+#include "userver/storages/postgres/component.hpp"
+#include "userver/storages/postgres/result_set.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+namespace {
+
+using userver::storages::postgres::ClusterHostType;
+
+// A row of get_follow_changes
+struct Change final {
+  std::int32_t follower_;
+  std::int32_t followed_;
+  bool following_;
+  std::chrono::system_clock::time_point changed_at_;
+};
+
+std::int64_t ToMicros(std::chrono::system_clock::time_point time_point) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             time_point.time_since_epoch())
+      .count();
+}
+
+void Apply(follows::FollowGraph& graph, std::int32_t follower,
+           std::int32_t followed, bool following) {
+  if (following) {
+    graph.Follow(follower, followed);
+  } else {
+    graph.Unfollow(follower, followed);
+  }
+}
+
+}  // namespace
+
+FollowGraph::FollowGraph(const userver::components::ComponentConfig& config,
+                         const userver::components::ComponentContext& context)
+    : CachingComponentBase(config, context),
+      cluster_(context
+                   .FindComponent<userver::components::Postgres>(
+                       "realworld-database")
+                   .GetCluster()),
+      chunk_size_(config["chunk-size"].As<std::int32_t>()),
+      update_correction_(
+          config["update-correction"].As<std::chrono::milliseconds>()) {
+  // The first load runs here, the service does not start without the graph
+  StartPeriodicUpdates();
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.follow-graph",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+}
+
+FollowGraph::~FollowGraph() {
+  statistics_holder_.Unregister();
+  StopPeriodicUpdates();
+}
+
+bool FollowGraph::IsFollowing(std::int32_t follower,
+                              std::int32_t followed) const {
+  return Get()->IsFollowing(follower, followed);
+}
+
+std::vector<bool> FollowGraph::AreFollowed(
+    std::int32_t follower, const std::vector<std::int32_t>& authors) const {
+  return Get()->AreFollowed(follower, authors);
+}
+
+std::vector<bool> FollowGraph::AreAuthorsFollowed(
+    std::optional<std::int32_t> viewer,
+    const userver::storages::postgres::ResultSet& rows) const {
+  if (!viewer || rows.IsEmpty()) {
+    return {};
+  }
+  std::vector<std::int32_t> authors;
+  authors.reserve(rows.Size());
+  for (const auto& row : rows) {
+    authors.push_back(row["author_id"].As<std::int32_t>());
+  }
+  return AreFollowed(*viewer, authors);
+}
+
+void FollowGraph::OnFollow(std::int32_t follower,
+                           const models::FollowResult& result) const {
+  OnWrite({follower, result.user_id_}, {true, result.changed_at_});
+}
+
+void FollowGraph::OnUnfollow(std::int32_t follower,
+                             const models::FollowResult& result) const {
+  OnWrite({follower, result.user_id_}, {false, result.changed_at_});
+}
+
+void FollowGraph::OnWrite(const Edge& edge, const Write& write) const {
+  // Under the lock, so that a write lands either in the pending writes of
+  // a load or in the graph that load has Set()
+  auto writes = writes_.Lock();
+  auto& recent = writes->recent_[edge];
+  if (recent.changed_at_ > write.changed_at_) {
+    // A later write of another instance was read already
+    return;
+  }
+  recent = write;
+  if (writes->graph_) {
+    Apply(*writes->graph_, edge.first, edge.second, write.following_);
+  }
+  if (writes->loading_) {
+    writes->pending_.emplace_back(edge, write);
+  }
+}
+
+std::unique_ptr<follows::FollowGraph> FollowGraph::Load(
+    userver::cache::UpdateStatisticsScope& stats_scope) const {
+  auto graph = std::make_unique<follows::FollowGraph>();
+  follows::FollowGraph::Edge last{0, 0};
+  // Chunks by primary key rather than one statement, so that no query runs
+  // longer than its timeout on a large graph
+  while (true) {
+    const auto res = cluster_->Execute(
+        ClusterHostType::kMaster, db::sql::kGetFollowerEdges.data(),
+        last.follower_, last.followed_, chunk_size_);
+    const auto edges = res.AsContainer<std::vector<follows::FollowGraph::Edge>>(
+        userver::storages::postgres::kRowTag);
+    stats_scope.IncreaseDocumentsReadCount(edges.size());
+    graph->Add(edges);
+    if (edges.size() < static_cast<std::size_t>(chunk_size_)) {
+      break;
+    }
+    last = edges.back();
+  }
+  graph->ShrinkToFit();
+  return graph;
+}
+
+void FollowGraph::Update(userver::cache::UpdateType type,
+                         const std::chrono::system_clock::time_point&,
+                         const std::chrono::system_clock::time_point&,
+                         userver::cache::UpdateStatisticsScope& stats_scope) {
+  // Full updates read the master: the loaded graph is the state of the
+  // edges from then on, so no write of this process needs to be replayed
+  // onto it other than those made while loading. Incremental updates read
+  // the change log of a replica.
+  const auto full = type == userver::cache::UpdateType::kFull;
+  const auto host_type =
+      full ? ClusterHostType::kMaster : ClusterHostType::kSlave;
+  std::unique_ptr<follows::FollowGraph> loaded;
+  auto changed_after = changed_after_;
+  if (full) {
+    {
+      auto writes = writes_.Lock();
+      writes->loading_ = true;
+      writes->pending_.clear();
+    }
+    try {
+      // Edges changed while the chunks are read are reread below
+      changed_after =
+          cluster_
+              ->Execute(host_type, db::sql::kGetFollowChangesWatermark.data())
+              .AsSingleRow<std::chrono::system_clock::time_point>();
+      loaded = Load(stats_scope);
+    } catch (...) {
+      writes_.Lock()->loading_ = false;
+      throw;
+    }
+  }
+  std::vector<Change> changes;
+  try {
+    const auto res = cluster_->Execute(
+        host_type, db::sql::kGetFollowChanges.data(),
+        ToMicros(changed_after - update_correction_));
+    changes = res.AsContainer<std::vector<Change>>(
+        userver::storages::postgres::kRowTag);
+  } catch (...) {
+    if (full) {
+      writes_.Lock()->loading_ = false;
+    }
+    throw;
+  }
+  stats_scope.IncreaseDocumentsReadCount(changes.size());
+  if (!full && changes.empty()) {
+    stats_scope.FinishNoChanges();
+    return;
+  }
+
+  auto writes = writes_.Lock();
+  auto& graph = full ? *loaded : *writes->graph_;
+  for (const auto& change : changes) {
+    changed_after = std::max(changed_after, change.changed_at_);
+    const Edge edge{change.follower_, change.followed_};
+    const auto recent = writes->recent_.find(edge);
+    if (recent != writes->recent_.end() &&
+        recent->second.changed_at_ >= change.changed_at_) {
+      // A replica behind the state this process knows
+      continue;
+    }
+    if (full) {
+      // A lagging replica may return an older state of the edge later
+      writes->recent_[edge] = {change.following_, change.changed_at_};
+    }
+    Apply(graph, change.follower_, change.followed_, change.following_);
+  }
+  if (full) {
+    for (const auto& [edge, write] : writes->pending_) {
+      Apply(graph, edge.first, edge.second, write.following_);
+    }
+    writes->pending_.clear();
+    writes->loading_ = false;
+  }
+  // Once the replica has shown a change update-correction after a state, it
+  // has every transaction that committed before, that state among them
+  const auto seen = changed_after - update_correction_;
+  for (auto it = writes->recent_.begin(); it != writes->recent_.end();) {
+    if (it->second.changed_at_ < seen) {
+      it = writes->recent_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  changed_after_ = changed_after;
+  const auto edges = graph.GetEdges();
+  if (full) {
+    writes->graph_ = loaded.get();
+    Set(std::move(loaded));
+  }
+  stats_scope.Finish(edges);
+}
+
+void FollowGraph::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  const auto graph = Get();
+  const auto memory = graph->GetMemory();
+  const auto edges = graph->GetEdges();
+  writer["edges"] = edges;
+  writer["followers"] = memory.followers_;
+  writer["bitmap-followers"] = memory.bitmap_followers_;
+  writer["bytes"] = memory.bytes_;
+  writer["bytes-per-edge"] = edges == 0 ? 0 : memory.bytes_ / edges;
+  writer["recent-writes"] = writes_.Lock()->recent_.size();
+}
+
+userver::yaml_config::Schema FollowGraph::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::CachingComponentBase<follows::FollowGraph>>(R"(
+type: object
+description: Who follows whom, for the following flags in responses
+additionalProperties: false
+properties:
+    chunk-size:
+        type: integer
+        description: edges read per statement by full updates
+    update-correction:
+        type: string
+        description: |
+            how far back incremental updates reread edge changes, longer
+            than any transaction that follows or unfollows
+)");
+}
+
+}  // namespace realworld::components
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "common/follow_graph.hpp"
+#include "models/profile.hpp"
+#include "userver/cache/caching_component_base.hpp"
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/concurrent/variable.hpp"
+#include "userver/storages/postgres/postgres_fwd.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Who follows whom, for the following flags of the profile, list, feed and
+// comments handlers.
+//
+// Full updates load the followers table from the master in chunks.
+// Incremental updates read the edges changed since the latest changed_at
+// seen, minus update-correction, from realworld.follow_changes on a
+// replica. Follows and unfollows of this process are applied right away.
+// A lagging replica can still return an older state of an edge. So the
+// states newer than what the replica has shown are kept as recent writes,
+// and older changes of those edges are skipped.
+class FollowGraph final
+    : public userver::components::CachingComponentBase<follows::FollowGraph> {
+ public:
+  static constexpr std::string_view kName{"follow-graph"};
+
+  FollowGraph(const userver::components::ComponentConfig& config,
+              const userver::components::ComponentContext& context);
+
+  ~FollowGraph() override;
+
+  bool IsFollowing(std::int32_t follower, std::int32_t followed) const;
+  std::vector<bool> AreFollowed(
+      std::int32_t follower, const std::vector<std::int32_t>& authors) const;
+
+  // Whether the viewer follows the author_id of each row, in their order.
+  // Empty without a viewer.
+  std::vector<bool> AreAuthorsFollowed(
+      std::optional<std::int32_t> viewer,
+      const userver::storages::postgres::ResultSet& rows) const;
+
+  // To be called with the row follow or unfollow returned
+  void OnFollow(std::int32_t follower,
+                const models::FollowResult& result) const;
+  void OnUnfollow(std::int32_t follower,
+                  const models::FollowResult& result) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  using Edge = std::pair<std::int32_t, std::int32_t>;
+
+  struct Write final {
+    bool following_;
+    std::chrono::system_clock::time_point changed_at_;
+  };
+
+  struct Writes final {
+    // The graph last Set(), which the cache keeps alive until the next one
+    follows::FollowGraph* graph_{nullptr};
+    bool loading_{false};
+    // Writes of this process made while loading, in their order
+    std::vector<std::pair<Edge, Write>> pending_;
+    // The newest known state of the edges changed after what the replica
+    // has shown, minus update-correction
+    std::map<Edge, Write> recent_;
+  };
+
+  void Update(userver::cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              userver::cache::UpdateStatisticsScope& stats_scope) override;
+
+  std::unique_ptr<follows::FollowGraph> Load(
+      userver::cache::UpdateStatisticsScope& stats_scope) const;
+
+  void OnWrite(const Edge& edge, const Write& write) const;
+
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  const userver::storages::postgres::ClusterPtr cluster_;
+  const std::int32_t chunk_size_;
+  const std::chrono::milliseconds update_correction_;
+
+  // The latest changed_at read, only used by Update()
+  std::chrono::system_clock::time_point changed_after_;
+  mutable userver::concurrent::Variable<Writes> writes_;
+  userver::utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool kHasValidate<realworld::components::FollowGraph> = true;
+
+}  // namespace userver::components
@@ -0,0 +1,118 @@
+#include "password_hasher.hpp"
+#include "bcrypt/BCrypt.hpp"
+#include "common/errors.hpp"
+#include "userver/components/statistics_storage.hpp"
+#include "userver/utils/async.hpp"
+#include "userver/utils/scope_guard.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+namespace {
+
+std::size_t ToMilliseconds(std::chrono::steady_clock::duration duration) {
+  return static_cast<std::size_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+}
+
+template <typename Percentile>
+void WriteTimings(userver::utils::statistics::Writer& writer,
+                  const Percentile& timings) {
+  writer["p50"] = timings.GetPercentile(50);
+  writer["p95"] = timings.GetPercentile(95);
+  writer["p99"] = timings.GetPercentile(99);
+  writer["p100"] = timings.GetPercentile(100);
+}
+
+}  // namespace
+
+PasswordHasher::PasswordHasher(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      task_processor_(context.GetTaskProcessor(
+          config["task_processor"].As<std::string>())),
+      max_queue_size_(config["max_queue_size"].As<std::size_t>()) {
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.password-hasher",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+}
+
+PasswordHasher::~PasswordHasher() { statistics_holder_.Unregister(); }
+
+template <typename Func>
+auto PasswordHasher::Run(std::string_view name, Func&& func) const {
+  if (queue_size_.fetch_add(1) >= max_queue_size_) {
+    queue_size_.fetch_sub(1);
+    rejected_.fetch_add(1);
+    throw errors::ServiceUnavailableError{
+        errors::ErrorBuilder{"server", "is overloaded, try again later"}};
+  }
+  const userver::utils::ScopeGuard queue_guard{
+      [this] { queue_size_.fetch_sub(1); }};
+
+  const auto enqueued_at = std::chrono::steady_clock::now();
+  return userver::utils::Async(
+             task_processor_, std::string{name},
+             [this, enqueued_at, func = std::forward<Func>(func)] {
+               const auto started_at = std::chrono::steady_clock::now();
+               wait_timings_.GetCurrentCounter().Account(
+                   ToMilliseconds(started_at - enqueued_at));
+               auto result = func();
+               hash_timings_.GetCurrentCounter().Account(
+                   ToMilliseconds(std::chrono::steady_clock::now() -
+                                  started_at));
+               return result;
+             })
+      .Get();
+}
+
+std::string PasswordHasher::GenerateHash(std::string password) const {
+  return Run("bcrypt-generate-hash", [password = std::move(password)] {
+    return BCrypt::generateHash(password);
+  });
+}
+
+bool PasswordHasher::ValidatePassword(std::string password,
+                                      std::string hash) const {
+  return Run("bcrypt-validate-password",
+             [password = std::move(password), hash = std::move(hash)] {
+               return BCrypt::validatePassword(password, hash);
+             });
+}
+
+void PasswordHasher::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  writer["queue-size"] = queue_size_.load();
+  writer["max-queue-size"] = max_queue_size_;
+  writer["rejected"] = rejected_.load();
+  auto wait_time_writer = writer["wait-time-ms"];
+  WriteTimings(wait_time_writer, wait_timings_.GetStatsForPeriod());
+  auto hash_time_writer = writer["hash-time-ms"];
+  WriteTimings(hash_time_writer, hash_timings_.GetStatsForPeriod());
+}
+
+userver::yaml_config::Schema PasswordHasher::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Runs bcrypt on a dedicated task processor
+additionalProperties: false
+properties:
+    task_processor:
+        type: string
+        description: task processor to run bcrypt on
+    max_queue_size:
+        type: integer
+        description: |
+            max number of pending and running hashes, further requests are
+            rejected with 503
+        minimum: 1
+)");
+}
+
+}  // namespace realworld::components
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/loggable_component_base.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/engine/task/task_processor_fwd.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/percentile.hpp"
+#include "userver/utils/statistics/recentperiod.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Runs bcrypt on a dedicated task processor, so that hashing bursts do not
+// occupy the workers that serve the rest of the API. At most
+// max_queue_size hashes may be pending or running at once, further calls
+// throw errors::ServiceUnavailableError right away.
+class PasswordHasher final
+    : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName{"password-hasher"};
+
+  PasswordHasher(const userver::components::ComponentConfig& config,
+                 const userver::components::ComponentContext& context);
+
+  ~PasswordHasher() override;
+
+  std::string GenerateHash(std::string password) const;
+
+  bool ValidatePassword(std::string password, std::string hash) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  // Milliseconds, exact below 1s and in 100ms buckets up to 60s, so that
+  // the waits of an overloaded queue are not all clipped to the top bucket
+  using Percentile =
+      userver::utils::statistics::Percentile<1000, std::uint32_t, 590, 100>;
+  using Timings =
+      userver::utils::statistics::RecentPeriod<Percentile, Percentile>;
+
+  template <typename Func>
+  auto Run(std::string_view name, Func&& func) const;
+
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  userver::engine::TaskProcessor& task_processor_;
+  const std::size_t max_queue_size_;
+
+  mutable std::atomic<std::size_t> queue_size_{0};
+  mutable std::atomic<std::uint64_t> rejected_{0};
+  mutable Timings wait_timings_;
+  mutable Timings hash_timings_;
+  userver::utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool kHasValidate<realworld::components::PasswordHasher> =
+    true;
+
+}  // namespace userver::components
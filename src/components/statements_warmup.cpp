@@ -0,0 +1,214 @@
+#include "statements_warmup.hpp"
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+#include "db/sql.hpp"
+#include "userver/components/statistics_storage.hpp"
+#include "userver/engine/task/task_with_result.hpp"
+#include "userver/logging/log.hpp"
+#include "userver/storages/postgres/cluster.hpp"
+#include "userver/storages/postgres/component.hpp"
+#include "userver/storages/postgres/exceptions.hpp"
+#include "userver/storages/postgres/statistics.hpp"
+#include "userver/utils/async.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+namespace {
+
+using userver::storages::postgres::ClusterHostType;
+using userver::storages::postgres::Transaction;
+
+// Binding NULLs prepares the statement on the transaction's connection
+// without running it. The driver caches statements under their text and
+// parameter types, so Args are the types the handlers pass.
+template <typename... Args>
+void Prepare(Transaction& transaction, std::string_view statement) {
+  transaction.MakePortal(statement.data(), std::optional<Args>{}...);
+}
+
+void PrepareStatements(Transaction& transaction) {
+  using Int = std::int32_t;
+  using Micros = std::int64_t;
+  using Text = std::string;
+  using Texts = std::vector<std::string>;
+
+  Prepare<Text, Text, Text, Text, Int, Texts>(transaction,
+                                              db::sql::kAddNewArticle);
+  Prepare<Int, Text>(transaction, db::sql::kFollow);
+  Prepare<Int, Text>(transaction, db::sql::kUnfollow);
+  Prepare<Int, Int>(transaction, db::sql::kIsFavoritedArticle);
+  Prepare<Int, Int>(transaction, db::sql::kGetProfile);
+  Prepare<Text, Int>(transaction, db::sql::kGetProfileByUsername);
+  Prepare<Int>(transaction, db::sql::kGetArticleTagList);
+  Prepare<Text, Int, Text, Text, Text, Text, Texts>(
+      transaction, db::sql::kUpdateArticleBySlug);
+  Prepare<Text, Int>(transaction, db::sql::kDeleteArticleBySlug);
+  Prepare<Text, Int>(transaction,
+                     db::sql::kGetArticleWithAuthorProfileBySlug);
+  Prepare<Int, Int>(transaction, db::sql::kGetArticleViewerFlags);
+  Prepare<Text>(transaction, db::sql::kGetArticleIdBySlug);
+  Prepare<Int, Int>(transaction, db::sql::kGetArticleWithAuthorProfile);
+  Prepare<Text, Text, Text, Int, Int, Int, Micros, Int>(
+      transaction, db::sql::kGetArticlesWithAuthorProfile);
+  Prepare<Int, Int, Int, Micros, Int>(transaction, db::sql::kGetFeed);
+  Prepare<Int, Int, Int>(transaction, db::sql::kGetFollowerEdges);
+  Prepare<Micros>(transaction, db::sql::kGetFollowChanges);
+  Prepare<>(transaction, db::sql::kGetFollowChangesWatermark);
+  Prepare<Text, Text, Text>(transaction, db::sql::kAddNewUser);
+  Prepare<Text>(transaction, db::sql::kGetUserByEmail);
+  Prepare<Text>(transaction, db::sql::kGetUserByUsername);
+  Prepare<Int>(transaction, db::sql::kGetUserById);
+  Prepare<Int, Text, Text, Text, Text, Text>(transaction,
+                                             db::sql::kUpdateUserById);
+  Prepare<Text, Int, Int, Micros, Int>(transaction,
+                                       db::sql::kGetCommentsFromArticle);
+  Prepare<Text, Text, Int>(transaction, db::sql::kAddNewComment);
+  Prepare<Int, Text, Int>(transaction, db::sql::kDeleteComment);
+  Prepare<Int, Int>(transaction, db::sql::kGetComment);
+  Prepare<Text, Int>(transaction, db::sql::kFavoriteArticle);
+  Prepare<Text, Int>(transaction, db::sql::kUnfavoriteArticle);
+  Prepare<Micros>(transaction, db::sql::kGetTags);
+}
+
+struct Counters final {
+  std::uint64_t opened_connections_{0};
+  std::uint64_t parsed_{0};
+  std::uint64_t executed_{0};
+};
+
+void Add(Counters& counters,
+         const userver::storages::postgres::InstanceStatsDescriptor& host) {
+  counters.opened_connections_ += host.stats.connection.open_total;
+  counters.parsed_ += host.stats.transaction.parse_total;
+  counters.executed_ += host.stats.transaction.execute_total;
+}
+
+Counters ReadCounters(const userver::storages::postgres::Cluster& cluster) {
+  const auto statistics = cluster.GetStatistics();
+  Counters counters;
+  Add(counters, statistics->master);
+  Add(counters, statistics->sync_slave);
+  for (const auto& slave : statistics->slaves) {
+    Add(counters, slave);
+  }
+  return counters;
+}
+
+}  // namespace
+
+StatementsWarmup::StatementsWarmup(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      cluster_(context
+                   .FindComponent<userver::components::Postgres>(
+                       "realworld-database")
+                   .GetCluster()),
+      connections_(config["connections"].As<std::size_t>()) {
+  // Components are created before the server starts listening, so the
+  // service is not ready until the warm-up is done
+  Warmup();
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.statements-warmup",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+  rewarm_task_.Start(
+      "statements-rewarm",
+      userver::utils::PeriodicTask::Settings{
+          config["rewarm_period"].As<std::chrono::milliseconds>()},
+      [this] { Rewarm(); });
+}
+
+StatementsWarmup::~StatementsWarmup() {
+  rewarm_task_.Stop();
+  statistics_holder_.Unregister();
+}
+
+void StatementsWarmup::Warmup() {
+  const auto parsed_before = ReadCounters(*cluster_).parsed_;
+  for (const auto host_type :
+       {ClusterHostType::kMaster, ClusterHostType::kSlave}) {
+    try {
+      // Every Begin takes another connection while the previous
+      // transactions are open
+      std::vector<Transaction> transactions;
+      transactions.reserve(connections_);
+      for (std::size_t i = 0; i < connections_; ++i) {
+        transactions.push_back(cluster_->Begin(host_type, Transaction::RO));
+      }
+      // The connections are independent, so they are prepared concurrently
+      // and the warm-up takes as many round trips as one connection needs
+      std::vector<userver::engine::TaskWithResult<void>> tasks;
+      tasks.reserve(transactions.size());
+      for (auto& transaction : transactions) {
+        tasks.push_back(
+            userver::utils::Async("statements-warmup", [&transaction] {
+              PrepareStatements(transaction);
+              transaction.Rollback();
+            }));
+      }
+      for (auto& task : tasks) {
+        task.Get();
+      }
+    } catch (const userver::storages::postgres::ClusterUnavailable& ex) {
+      if (host_type == ClusterHostType::kMaster) {
+        throw;
+      }
+      LOG_INFO() << "No standby to warm up: " << ex;
+      continue;
+    }
+    warmed_connections_.fetch_add(connections_);
+  }
+  const auto counters = ReadCounters(*cluster_);
+  opened_connections_ = counters.opened_connections_;
+  warmup_parsed_.fetch_add(counters.parsed_ - parsed_before);
+  warmups_.fetch_add(1);
+}
+
+void StatementsWarmup::Rewarm() {
+  if (ReadCounters(*cluster_).opened_connections_ != opened_connections_) {
+    Warmup();
+  }
+}
+
+void StatementsWarmup::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  // A statement is parsed on its first execution on a connection, so
+  // executions that needed a parse, other than the warm-up's, ran cold.
+  // Parses of requests that overlap a rewarm are counted as the warm-up's.
+  const auto counters = ReadCounters(*cluster_);
+  const auto warmup_parsed = warmup_parsed_.load();
+  const auto cold = counters.parsed_ > warmup_parsed
+                        ? counters.parsed_ - warmup_parsed
+                        : 0;
+  writer["warmups"] = warmups_.load();
+  writer["warmed-connections"] = warmed_connections_.load();
+  writer["executions"]["cold"] = cold;
+  writer["executions"]["warm"] =
+      counters.executed_ > cold ? counters.executed_ - cold : 0;
+}
+
+userver::yaml_config::Schema StatementsWarmup::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Prepares the db::sql statements on the database connections
+additionalProperties: false
+properties:
+    connections:
+        type: integer
+        description: connections to warm up per host type, min_pool_size
+        minimum: 1
+    rewarm_period:
+        type: string
+        description: how often to check for new connections and warm them up
+)");
+}
+
+}  // namespace realworld::components
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/loggable_component_base.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/storages/postgres/postgres_fwd.hpp"
+#include "userver/utils/periodic_task.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Prepares every db::sql statement on `connections` database connections
+// before the service starts taking requests, so that the first requests
+// after a deploy or failover do not pay for parsing and planning. The
+// driver has no hook for new connections, so the warm-up is repeated every
+// rewarm_period once the driver has opened connections since the last one.
+class StatementsWarmup final
+    : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName{"statements-warmup"};
+
+  StatementsWarmup(const userver::components::ComponentConfig& config,
+                   const userver::components::ComponentContext& context);
+
+  ~StatementsWarmup() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void Warmup();
+
+  void Rewarm();
+
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  const userver::storages::postgres::ClusterPtr cluster_;
+  const std::size_t connections_;
+
+  // Connections opened by the driver as of the last warm-up, only touched
+  // by the constructor and the periodic task
+  std::uint64_t opened_connections_{0};
+
+  std::atomic<std::uint64_t> warmups_{0};
+  std::atomic<std::uint64_t> warmed_connections_{0};
+  std::atomic<std::uint64_t> warmup_parsed_{0};
+  userver::utils::PeriodicTask rewarm_task_;
+  userver::utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool kHasValidate<realworld::components::StatementsWarmup> =
+    true;
+
+}  // namespace userver::components
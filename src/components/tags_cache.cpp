@@ -0,0 +1,101 @@
+#include "tags_cache.hpp"
+#include <optional>
+#include <utility>
+#include <vector>
+#include "db/sql.hpp"
+#include "userver/components/statistics_storage.hpp"
+#include "userver/storages/postgres/cluster.hpp"
+#include "userver/storages/postgres/component.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+namespace {
+
+std::int64_t ToMicros(std::chrono::system_clock::time_point time_point) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             time_point.time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+TagsCache::TagsCache(const userver::components::ComponentConfig& config,
+                     const userver::components::ComponentContext& context)
+    : CachingComponentBase(config, context),
+      cluster_(context
+                   .FindComponent<userver::components::Postgres>(
+                       "realworld-database")
+                   .GetCluster()),
+      update_correction_(
+          config["update-correction"].As<std::chrono::milliseconds>()) {
+  // The first update runs here, the service does not start without tags
+  StartPeriodicUpdates();
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.tags-cache",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+}
+
+TagsCache::~TagsCache() {
+  statistics_holder_.Unregister();
+  StopPeriodicUpdates();
+}
+
+void TagsCache::Update(userver::cache::UpdateType type,
+                       const std::chrono::system_clock::time_point& last_update,
+                       const std::chrono::system_clock::time_point& now,
+                       userver::cache::UpdateStatisticsScope& stats_scope) {
+  std::optional<std::int64_t> updated_after;
+  if (type == userver::cache::UpdateType::kIncremental) {
+    updated_after = ToMicros(last_update - update_correction_);
+  }
+  // The watermark is the master's clock, a standby behind it by more than
+  // update-correction would make the cache miss changes until a full update
+  const auto res = cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      db::sql::kGetTags.data(), updated_after);
+  const auto changes = res.AsContainer<std::vector<tags::Tag>>(
+      userver::storages::postgres::kRowTag);
+  stats_scope.IncreaseDocumentsReadCount(changes.size());
+
+  if (type == userver::cache::UpdateType::kIncremental && changes.empty()) {
+    updated_at_ = ToMicros(now);
+    stats_scope.FinishNoChanges();
+    return;
+  }
+  auto tag_set = type == userver::cache::UpdateType::kIncremental
+                     ? Get()->Apply(changes)
+                     : tags::TagSet{}.Apply(changes);
+  const auto size = tag_set.GetSize();
+  Set(std::move(tag_set));
+  updated_at_ = ToMicros(now);
+  stats_scope.Finish(size);
+}
+
+void TagsCache::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  const auto tag_set = Get();
+  writer["size"] = tag_set->GetSize();
+  writer["response-bytes"] = tag_set->GetResponseBody().size();
+  writer["age-ms"] =
+      (ToMicros(std::chrono::system_clock::now()) - updated_at_.load()) / 1000;
+}
+
+userver::yaml_config::Schema TagsCache::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::CachingComponentBase<tags::TagSet>>(R"(
+type: object
+description: Tags in use ranked by articles, and the GET /api/tags body
+additionalProperties: false
+properties:
+    update-correction:
+        type: string
+        description: how far back incremental updates reread tag changes
+)");
+}
+
+}  // namespace realworld::components
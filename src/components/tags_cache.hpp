@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include "common/tag_set.hpp"
+#include "userver/cache/caching_component_base.hpp"
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/storages/postgres/postgres_fwd.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Tags in use ranked by their articles, served by GET /api/tags.
+// Incremental updates read the tags touched since the previous update, minus
+// update-correction for the transactions that were still running then; full
+// updates reread them all.
+class TagsCache final
+    : public userver::components::CachingComponentBase<tags::TagSet> {
+ public:
+  static constexpr std::string_view kName{"tags-cache"};
+
+  TagsCache(const userver::components::ComponentConfig& config,
+            const userver::components::ComponentContext& context);
+
+  ~TagsCache() override;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void Update(userver::cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              userver::cache::UpdateStatisticsScope& stats_scope) override;
+
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  const userver::storages::postgres::ClusterPtr cluster_;
+  const std::chrono::milliseconds update_correction_;
+
+  // Start of the last successful update, microseconds since the epoch
+  std::atomic<std::int64_t> updated_at_{0};
+  userver::utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool kHasValidate<realworld::components::TagsCache> = true;
+
+}  // namespace userver::components
@@ -0,0 +1,50 @@
+#include "token_cache.hpp"
+#include "userver/components/statistics_storage.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+TokenCache::TokenCache(const userver::components::ComponentConfig& config,
+                       const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      cache_(config["ways"].As<std::size_t>(),
+             config["way_size"].As<std::size_t>()) {
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.token-cache",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+}
+
+TokenCache::~TokenCache() { statistics_holder_.Unregister(); }
+
+const auth::TokenCache& TokenCache::GetCache() const { return cache_; }
+
+void TokenCache::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  writer["size"] = cache_.GetSize();
+  writer["hits"] = cache_.GetHits();
+  writer["misses"] = cache_.GetMisses();
+}
+
+userver::yaml_config::Schema TokenCache::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Cache of verified JWT tokens shared by all auth checkers
+additionalProperties: false
+properties:
+    ways:
+        type: integer
+        description: number of independently locked cache shards
+        minimum: 1
+    way_size:
+        type: integer
+        description: max number of tokens in each shard
+        minimum: 1
+)");
+}
+
+}  // namespace realworld::components
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string_view>
+#include "common/token_cache.hpp"
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/loggable_component_base.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Verified-token cache shared by the auth checkers of all handlers
+class TokenCache final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName{"token-cache"};
+
+  TokenCache(const userver::components::ComponentConfig& config,
+             const userver::components::ComponentContext& context);
+
+  ~TokenCache() override;
+
+  const auth::TokenCache& GetCache() const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  const auth::TokenCache cache_;
+  userver::utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool kHasValidate<realworld::components::TokenCache> = true;
+
+}  // namespace userver::components
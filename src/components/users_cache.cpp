@@ -0,0 +1,68 @@
+#include "users_cache.hpp"
+#include "userver/components/statistics_storage.hpp"
+#include "userver/yaml_config/merge_schemas.hpp"
+
+namespace realworld::components {
+
+UsersCache::UsersCache(const userver::components::ComponentConfig& config,
+                       const userver::components::ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      snapshot_(context.FindComponent<UsersSnapshot>()),
+      recent_users_(
+          config["recent-writes-max-age"].As<std::chrono::milliseconds>()) {
+  statistics_holder_ =
+      context.FindComponent<userver::components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("realworld.users-cache",
+                          [this](userver::utils::statistics::Writer& writer) {
+                            WriteStatistics(writer);
+                          });
+  reset_registration_ = userver::testsuite::RegisterCache(
+      config, context, this, &UsersCache::ResetCache);
+}
+
+UsersCache::~UsersCache() { statistics_holder_.Unregister(); }
+
+users::UserPtr UsersCache::FindById(std::int32_t id) const {
+  return recent_users_.FindById(*snapshot_.Get(), id);
+}
+
+users::UserPtr UsersCache::FindByUsername(std::string_view username) const {
+  return recent_users_.FindByUsername(*snapshot_.Get(), username);
+}
+
+void UsersCache::OnUpdate(const models::User& user) const {
+  recent_users_.Put(
+      {user.id_, user.username_, user.email_, user.bio_, user.image_});
+  // Reread the changed users now rather than on the next update-interval
+  snapshot_.InvalidateAsync(userver::cache::UpdateType::kIncremental);
+}
+
+void UsersCache::ResetCache() { recent_users_.Clear(); }
+
+void UsersCache::WriteStatistics(
+    userver::utils::statistics::Writer& writer) const {
+  const auto snapshot = snapshot_.Get();
+  writer["size"] = snapshot->size();
+  writer["bytes"] = snapshot->GetBytes();
+  writer["bytes-per-user"] =
+      snapshot->size() == 0 ? 0 : snapshot->GetBytes() / snapshot->size();
+  writer["recent-writes"] = recent_users_.GetSize();
+}
+
+userver::yaml_config::Schema UsersCache::GetStaticConfigSchema() {
+  return userver::yaml_config::MergeSchemas<
+      userver::components::LoggableComponentBase>(R"(
+type: object
+description: Users by id and username, with this process' writes applied
+additionalProperties: false
+properties:
+    recent-writes-max-age:
+        type: string
+        description: |
+            how long users updated by this process are served from memory
+            rather than from the snapshot, longer than an incremental update
+)");
+}
+
+}  // namespace realworld::components
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include "common/user_index.hpp"
+#include "models/user.hpp"
+#include "userver/cache/base_postgres_cache.hpp"
+#include "userver/components/component_config.hpp"
+#include "userver/components/component_context.hpp"
+#include "userver/components/loggable_component_base.hpp"
+#include "userver/components/static_config_validator.hpp"
+#include "userver/storages/postgres/io/chrono.hpp"
+#include "userver/testsuite/cache_control.hpp"
+#include "userver/utils/statistics/entry.hpp"
+#include "userver/utils/statistics/writer.hpp"
+#include "userver/yaml_config/schema.hpp"
+
+namespace realworld::components {
+
+// Every user without the password hash. Incremental updates reread the
+// users updated since the previous update minus update-correction.
+struct UsersSnapshotPolicy final {
+  static constexpr std::string_view kName{"users-snapshot"};
+
+  using ValueType = models::UserRecord;
+  using CacheContainer = users::UserIndex;
+  static constexpr auto kKeyMember = &models::UserRecord::id_;
+
+  static constexpr std::string_view kQuery{R"~(
+SELECT user_id, username::TEXT, email, bio, image FROM realworld.users
+)~"};
+  static constexpr std::string_view kUpdatedField{"updated_at"};
+  using UpdatedFieldType = userver::storages::postgres::TimePointTz;
+
+  // The watermark is the master's clock, see TagsCache
+  static constexpr auto kClusterHostType =
+      userver::storages::postgres::ClusterHostType::kMaster;
+};
+
+using UsersSnapshot = userver::components::PostgreCache<UsersSnapshotPolicy>;
+
+// Users by id and username for the handlers: the snapshot, overlaid with
+// the users updated by this process since it was read
+class UsersCache final : public userver::components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName{"users-cache"};
+
+  UsersCache(const userver::components::ComponentConfig& config,
+             const userver::components::ComponentContext& context);
+
+  ~UsersCache() override;
+
+  // nullptr if the user is not cached yet, e.g. registered since the last
+  // update, or does not exist: look it up in the database then
+  users::UserPtr FindById(std::int32_t id) const;
+  users::UserPtr FindByUsername(std::string_view username) const;
+
+  // To be called with the row update_user_by_id returned
+  void OnUpdate(const models::User& user) const;
+
+  static userver::yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+  // Testsuite drops the recent writes between tests with the snapshot
+  void ResetCache();
+
+  UsersSnapshot& snapshot_;
+  const users::RecentUsers recent_users_;
+  userver::utils::statistics::Entry statistics_holder_;
+  userver::testsuite::CacheResetRegistration reset_registration_;
+};
+
+}  // namespace realworld::components
+
+namespace userver::components {
+
+template <>
+inline constexpr bool kHasValidate<realworld::components::UsersCache> = true;
+
+}  // namespace userver::components
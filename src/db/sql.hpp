@@ -4,20 +4,19 @@
 
 namespace realworld::db::sql {
 
+// Every statement is prepared on the pool's connections by
+// components::StatementsWarmup, a new one needs an entry there too
+
 inline constexpr std::string_view kAddNewArticle{R"~(
 SELECT realworld.add_new_article($1, $2, $3, $4, $5, $6)
 )~"};
 
-inline constexpr std::string_view kIsFollowing{R"~(
-SELECT realworld.is_following($1, $2)
-)~"};
-
 inline constexpr std::string_view kFollow{R"~(
-SELECT realworld.follow($1, $2)
+SELECT user_id, changed_at, profile FROM realworld.follow($1, $2::CITEXT)
 )~"};
 
 inline constexpr std::string_view kUnfollow{R"~(
-SELECT realworld.unfollow($1, $2)
+SELECT user_id, changed_at, profile FROM realworld.unfollow($1, $2::CITEXT)
 )~"};
 
 inline constexpr std::string_view kIsFavoritedArticle{R"~(
@@ -37,7 +36,7 @@ SELECT realworld.get_article_tag_list($1)
 )~"};
 
 inline constexpr std::string_view kUpdateArticleBySlug{R"~(
-SELECT realworld.update_article_by_slug($1, $2, $3, $4, $5, $6)
+SELECT owned, article FROM realworld.update_article_by_slug($1, $2, $3, $4, $5, $6, $7)
 )~"};
 
 inline constexpr std::string_view kDeleteArticleBySlug{R"~(
@@ -48,16 +47,41 @@ inline constexpr std::string_view kGetArticleWithAuthorProfileBySlug{R"~(
 SELECT realworld.get_article_with_author_profile_by_slug($1, $2)
 )~"};
 
+inline constexpr std::string_view kGetArticleViewerFlags{R"~(
+SELECT favorited, following FROM realworld.get_article_viewer_flags($1, $2)
+)~"};
+
+inline constexpr std::string_view kGetArticleIdBySlug{R"~(
+SELECT * FROM realworld.get_article_id_by_slug($1)
+)~"};
+
 inline constexpr std::string_view kGetArticleWithAuthorProfile{R"~(
 SELECT realworld.get_article_with_author_profile($1, $2)
 )~"};
 
+// Cursor timestamps are passed as microseconds since the epoch, which is
+// exact and independent of the driver's timestamp mapping
 inline constexpr std::string_view kGetArticlesWithAuthorProfile = R"~(
-SELECT realworld.get_articles_with_author_profile($1, $2::CITEXT, $3::CITEXT, $4, $5, $6)
+SELECT * FROM realworld.get_articles_with_author_profile($1, $2::CITEXT, $3::CITEXT, $4, $5, $6,
+  TIMESTAMPTZ 'epoch' + $7::BIGINT * INTERVAL '1 microsecond', $8)
 )~";
 
 inline constexpr std::string_view kGetFeed{R"~(
-SELECT realworld.get_feed($1, $2, $3)
+SELECT * FROM realworld.get_feed($1, $2, $3,
+  TIMESTAMPTZ 'epoch' + $4::BIGINT * INTERVAL '1 microsecond', $5)
+)~"};
+
+inline constexpr std::string_view kGetFollowerEdges{R"~(
+SELECT * FROM realworld.get_follower_edges($1, $2, $3)
+)~"};
+
+inline constexpr std::string_view kGetFollowChanges{R"~(
+SELECT * FROM realworld.get_follow_changes(
+  TIMESTAMPTZ 'epoch' + $1::BIGINT * INTERVAL '1 microsecond')
+)~"};
+
+inline constexpr std::string_view kGetFollowChangesWatermark{R"~(
+SELECT realworld.get_follow_changes_watermark()
 )~"};
 
 inline constexpr std::string_view kAddNewUser{R"~(
@@ -81,7 +105,8 @@ SELECT realworld.update_user_by_id($1, $2::CITEXT, $3, $4, $5, $6)
 )~"};
 
 inline constexpr std::string_view kGetCommentsFromArticle{R"~(
-SELECT realworld.get_comments_from_article($1, $2)
+SELECT * FROM realworld.get_comments_from_article($1, $2, $3,
+  TIMESTAMPTZ 'epoch' + $4::BIGINT * INTERVAL '1 microsecond', $5)
 )~"};
 
 inline constexpr std::string_view kAddNewComment{R"~(
@@ -105,15 +130,8 @@ SELECT realworld.unfavorite_article($1, $2)
 )~"};
 
 inline constexpr std::string_view kGetTags{R"~(
-SELECT realworld.get_tags()
-)~"};
-
-inline constexpr std::string_view kGetArticleIdBySlug{R"~(
-SELECT realworld.get_article_id_by_slug($1)
-)~"};
-
-inline constexpr std::string_view kIsCommentExist{R"~(
-SELECT realworld.is_comment_exist($1, $2, $3)
+SELECT name, articles_count FROM realworld.get_tags(
+  TIMESTAMPTZ 'epoch' + $1::BIGINT * INTERVAL '1 microsecond')
 )~"};
 
 }  // namespace realworld::db::sql
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string_view>
+#include <userver/storages/postgres/io/buffer_io_base.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/pg_types.hpp>
+#include <userver/storages/postgres/io/type_mapping.hpp>
+
+namespace realworld::db {
+
+// Text value decoded without a copy. It points into the result set it was
+// read from and is valid only while that result set is alive.
+struct TextView final {
+  std::string_view value_;
+
+  operator std::string_view() const { return value_; }
+};
+
+}  // namespace realworld::db
+
+namespace userver::storages::postgres::io {
+
+template <>
+struct BufferParser<realworld::db::TextView>
+    : detail::BufferParserBase<realworld::db::TextView> {
+  using BaseType::BaseType;
+
+  void operator()(const FieldBuffer& buffer) {
+    value.value_ = std::string_view{
+        reinterpret_cast<const char*>(buffer.buffer), buffer.length};
+  }
+};
+
+template <>
+struct CppToSystemPg<realworld::db::TextView>
+    : PredefinedOid<PredefinedOids::kText> {};
+
+}  // namespace userver::storages::postgres::io
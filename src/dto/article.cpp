@@ -1,7 +1,66 @@
 #include "article.hpp"
+#include <boost/algorithm/string/case_conv.hpp>
+#include "common/utils.hpp"
 
 namespace realworld::dto {
 
+namespace {
+
+std::optional<std::vector<std::string>> ReadTags(json::Reader& reader) {
+  auto tags = utils::ReadOptionalStringArray(reader, "tagList");
+  if (tags) {
+    for (auto& tag : *tags) {
+      utils::CheckLength(tag, "tagList", 2, 256);
+      boost::algorithm::to_lower(tag);
+    }
+  }
+  return tags;
+}
+
+// Shared by the owning models and the views over a result set
+template <typename Model>
+void WriteArticle(const Model& article,
+                  const models::ArticleViewerFlags& flags,
+                  userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("slug");
+  sw.WriteString(article.slug_);
+  sw.Key("title");
+  sw.WriteString(article.title_);
+  sw.Key("description");
+  sw.WriteString(article.description_);
+  sw.Key("body");
+  sw.WriteString(article.body_);
+  sw.Key("tagList");
+  {
+    userver::formats::json::StringBuilder::ArrayGuard tags_guard{sw};
+    if (article.tag_list_) {
+      for (const auto& tag : *article.tag_list_) {
+        sw.WriteString(tag);
+      }
+    }
+  }
+  sw.Key("createdAt");
+  userver::formats::json::WriteToStream(article.created_at_, sw);
+  sw.Key("updatedAt");
+  userver::formats::json::WriteToStream(article.updated_at_, sw);
+  sw.Key("favoritesCount");
+  sw.WriteInt64(article.favorites_count_);
+  sw.Key("favorited");
+  sw.WriteBool(flags.favorited_);
+  sw.Key("author");
+  WriteToStream(article.author_, flags.following_, sw);
+}
+
+template <typename Model>
+void WriteArticle(const Model& article,
+                  userver::formats::json::StringBuilder& sw) {
+  WriteArticle(article, {article.favorited_, article.author_.following_},
+               sw);
+}
+
+}  // namespace
+
 Article Article::Parse(const models::ArticleWithAuthorProfile& model) {
   Article article;
   article.slug_ = model.slug_;
@@ -42,4 +101,107 @@ userver::formats::json::Value Serialize(
   return builder.ExtractValue();
 }
 
+void WriteToStream(const models::ArticleWithAuthorProfile& article,
+                   userver::formats::json::StringBuilder& sw) {
+  WriteArticle(article, sw);
+}
+
+void WriteToStream(const models::ArticleWithAuthorProfileView& article,
+                   userver::formats::json::StringBuilder& sw) {
+  WriteArticle(article, sw);
+}
+
+void WriteToStream(const models::ArticleWithAuthorProfile& article,
+                   bool following, userver::formats::json::StringBuilder& sw) {
+  WriteArticle(article, {article.favorited_, following}, sw);
+}
+
+void WriteToStream(const models::ArticleWithAuthorProfileView& article,
+                   bool following, userver::formats::json::StringBuilder& sw) {
+  WriteArticle(article, {article.favorited_, following}, sw);
+}
+
+std::string ToArticleJson(const models::ArticleWithAuthorProfile& article) {
+  return ToArticleJson(article,
+                       {article.favorited_, article.author_.following_});
+}
+
+std::string ToArticleJson(const models::ArticleWithAuthorProfile& article,
+                          const models::ArticleViewerFlags& flags) {
+  userver::formats::json::StringBuilder sw;
+  {
+    userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+    sw.Key("article");
+    WriteArticle(article, flags, sw);
+  }
+  return sw.GetString();
+}
+
+NewArticleRequest NewArticleRequest::Parse(std::string_view request_body) {
+  NewArticleRequest request;
+  bool has_title{false};
+  bool has_description{false};
+  bool has_body{false};
+  utils::ReadRequestObject(
+      request_body, "article",
+      [&](json::Reader& reader, std::string_view key) {
+        if (key == "title") {
+          request.title_ = utils::ReadString(reader, key);
+          utils::CheckLength(request.title_, key, 3, 256);
+          has_title = true;
+        } else if (key == "description") {
+          request.description_ = utils::ReadString(reader, key);
+          utils::CheckLength(request.description_, key, 5, 8192);
+          has_description = true;
+        } else if (key == "body") {
+          request.body_ = utils::ReadString(reader, key);
+          utils::CheckLength(request.body_, key, 5, 65535);
+          has_body = true;
+        } else if (key == "tagList") {
+          request.tag_list_ = ReadTags(reader);
+        } else {
+          reader.Skip();
+        }
+      });
+  utils::CheckRequired(has_title, "title");
+  utils::CheckRequired(has_description, "description");
+  utils::CheckRequired(has_body, "body");
+  return request;
+}
+
+UpdateArticleRequest UpdateArticleRequest::Parse(
+    std::string_view request_body) {
+  UpdateArticleRequest request;
+  utils::ReadRequestObject(
+      request_body, "article",
+      [&request](json::Reader& reader, std::string_view key) {
+        if (key == "title") {
+          request.title_ = utils::ReadOptionalString(reader, key);
+          if (request.title_) {
+            utils::CheckLength(*request.title_, key, 3, 255);
+          }
+        } else if (key == "description") {
+          request.description_ = utils::ReadOptionalString(reader, key);
+          if (request.description_) {
+            utils::CheckLength(*request.description_, key, 5, 8192);
+          }
+        } else if (key == "body") {
+          request.body_ = utils::ReadOptionalString(reader, key);
+          if (request.body_) {
+            utils::CheckLength(*request.body_, key, 5, 65535);
+          }
+        } else if (key == "tagList") {
+          request.tag_list_ = ReadTags(reader);
+        } else {
+          reader.Skip();
+        }
+      });
+  if (!request.title_ && !request.description_ && !request.body_ &&
+      !request.tag_list_) {
+    throw errors::ValidationError{
+        errors::ErrorBuilder{"article", "cannot be empty"}};
+  }
+  return request;
+}
+
 }  // namespace realworld::dto
\ No newline at end of file
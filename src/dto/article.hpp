@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "common/pagination.hpp"
 #include "models/article.hpp"
 #include "profile.hpp"
 #include "userver/formats/json.hpp"
+#include "userver/formats/json/string_builder.hpp"
 
 namespace realworld::dto {
 
@@ -28,7 +32,71 @@ userver::formats::json::Value Serialize(
     const Article& data,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+// Writes the same JSON as Serialize(Article::Parse(article)) without the
+// intermediate copies
+void WriteToStream(const models::ArticleWithAuthorProfile& article,
+                   userver::formats::json::StringBuilder& sw);
+void WriteToStream(const models::ArticleWithAuthorProfileView& article,
+                   userver::formats::json::StringBuilder& sw);
+// The same with following in place of article.author_.following_
+void WriteToStream(const models::ArticleWithAuthorProfile& article,
+                   bool following, userver::formats::json::StringBuilder& sw);
+void WriteToStream(const models::ArticleWithAuthorProfileView& article,
+                   bool following, userver::formats::json::StringBuilder& sw);
+
+// {"article": {...}}
+std::string ToArticleJson(const models::ArticleWithAuthorProfile& article);
+// The same with the viewer columns taken from flags, for cached articles
+std::string ToArticleJson(const models::ArticleWithAuthorProfile& article,
+                          const models::ArticleViewerFlags& flags);
+
+// {"articles": [...], "articlesCount": N}, articles is any range of
+// models::ArticleWithAuthorProfile(View), e.g. a typed result set. With a
+// page_limit "nextCursor" is added: the cursor of the last article if the
+// page is full, null otherwise. A non-empty following holds the author
+// flags of the articles in their order, e.g. from the follow graph.
+template <typename Articles>
+std::string ToArticleListJson(
+    const Articles& articles,
+    std::optional<std::int32_t> page_limit = std::nullopt,
+    const std::vector<bool>& following = {}) {
+  userver::formats::json::StringBuilder sw;
+  {
+    userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+    std::size_t count{0};
+    pagination::Cursor last;
+    sw.Key("articles");
+    {
+      userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+      for (const auto& article : articles) {
+        if (following.empty()) {
+          WriteToStream(article, sw);
+        } else {
+          WriteToStream(article, following[count], sw);
+        }
+        last = {article.created_at_, article.article_id_};
+        ++count;
+      }
+    }
+    sw.Key("articlesCount");
+    sw.WriteUInt64(count);
+    if (page_limit) {
+      sw.Key("nextCursor");
+      if (count > 0 && count == static_cast<std::size_t>(*page_limit)) {
+        sw.WriteString(pagination::EncodeCursor(last));
+      } else {
+        sw.WriteNull();
+      }
+    }
+  }
+  return sw.GetString();
+}
+
 struct NewArticleRequest final {
+  // Parses and validates a {"article": {...}} body, throws
+  // errors::ValidationError
+  static NewArticleRequest Parse(std::string_view request_body);
+
   std::string title_;
   std::string description_;
   std::string body_;
@@ -39,16 +107,17 @@ struct ArticlesListRequest final {
   std::optional<std::string> tag_;
   std::optional<std::string> author_;
   std::optional<std::string> favorited_;
-  std::optional<std::int32_t> limit_;
-  std::optional<std::int32_t> offset_;
+  pagination::Page page_;
 };
 
 struct FeedRequest final {
-  std::optional<std::int32_t> limit_;
-  std::optional<std::int32_t> offset_;
+  pagination::Page page_;
 };
 
 struct UpdateArticleRequest final {
+  // Parses and validates a {"article": {...}} body, the slug is left empty
+  static UpdateArticleRequest Parse(std::string_view request_body);
+
   std::string slug_;
   std::optional<std::string> title_;
   std::optional<std::string> description_;
@@ -0,0 +1,161 @@
+#include "article.hpp"
+#include <benchmark/benchmark.h>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include "common/allocations.hpp"
+#include "common/utils.hpp"
+
+namespace realworld {
+
+namespace {
+
+// A full page of articles with long bodies, the typical list response
+std::vector<models::ArticleWithAuthorProfile> MakeArticles(
+    std::size_t body_size) {
+  std::vector<models::ArticleWithAuthorProfile> articles(20);
+  for (std::size_t i = 0; i < articles.size(); ++i) {
+    auto& article = articles[i];
+    article.article_id_ = static_cast<int>(i);
+    article.title_ = "How to train your dragon " + std::to_string(i);
+    article.slug_ = "how-to-train-your-dragon-" + std::to_string(i);
+    article.description_ = "Ever wonder how?";
+    article.body_ = std::string(body_size, 'x');
+    article.created_at_ = std::chrono::system_clock::now();
+    article.updated_at_ = article.created_at_;
+    article.tag_list_ = std::vector<std::string>{"dragons", "training"};
+    article.favorites_count_ = static_cast<std::int64_t>(i);
+    article.author_.username_ = "jake";
+    article.author_.bio_ = "I work at statefarm";
+  }
+  return articles;
+}
+
+// The views point into the rows the way they point into a result set
+std::vector<models::ArticleWithAuthorProfileView> MakeViews(
+    const std::vector<models::ArticleWithAuthorProfile>& articles) {
+  std::vector<models::ArticleWithAuthorProfileView> views(articles.size());
+  for (std::size_t i = 0; i < articles.size(); ++i) {
+    const auto& article = articles[i];
+    auto& view = views[i];
+    view.article_id_ = article.article_id_;
+    view.title_ = db::TextView{article.title_};
+    view.slug_ = db::TextView{article.slug_};
+    view.description_ = db::TextView{article.description_};
+    view.body_ = db::TextView{article.body_};
+    view.created_at_ = article.created_at_;
+    view.updated_at_ = article.updated_at_;
+    view.tag_list_.emplace();
+    for (const auto& tag : *article.tag_list_) {
+      view.tag_list_->push_back(db::TextView{tag});
+    }
+    view.favorites_count_ = article.favorites_count_;
+    view.author_ = article.author_;
+  }
+  return views;
+}
+
+// Counted by the operator new of common/allocations, as in the service's
+// realworld.allocations metrics
+void ReportAllocations(benchmark::State& state,
+                       const allocations::Scope& scope) {
+  const auto counters = scope.Get();
+  state.counters["allocs"] =
+      benchmark::Counter(static_cast<double>(counters.count_),
+                         benchmark::Counter::kAvgIterations);
+  state.counters["allocated-bytes"] =
+      benchmark::Counter(static_cast<double>(counters.bytes_),
+                         benchmark::Counter::kAvgIterations);
+}
+
+std::string MakeNewArticleBody(std::size_t body_size) {
+  userver::formats::json::ValueBuilder builder;
+  builder["article"]["title"] = "How to train your dragon";
+  builder["article"]["description"] = "Ever wonder how?";
+  builder["article"]["body"] = std::string(body_size, 'x') + "\n\"quoted\"";
+  builder["article"]["tagList"].PushBack("dragons");
+  builder["article"]["tagList"].PushBack("training");
+  return userver::formats::json::ToString(builder.ExtractValue());
+}
+
+}  // namespace
+
+void ArticleListValueBuilderBenchmark(benchmark::State& state) {
+  const auto articles = MakeArticles(state.range(0));
+  const allocations::Scope scope;
+  for (auto _ : state) {
+    userver::formats::json::ValueBuilder builder;
+    builder["articles"] = userver::formats::common::Type::kArray;
+    for (const auto& article : articles) {
+      builder["articles"].PushBack(dto::Article::Parse(article));
+    }
+    builder["articlesCount"] = articles.size();
+    benchmark::DoNotOptimize(
+        userver::formats::json::ToString(builder.ExtractValue()));
+  }
+  ReportAllocations(state, scope);
+}
+BENCHMARK(ArticleListValueBuilderBenchmark)->Arg(256)->Arg(16384);
+
+void ArticleListStreamBenchmark(benchmark::State& state) {
+  const auto articles = MakeArticles(state.range(0));
+  const allocations::Scope scope;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dto::ToArticleListJson(articles));
+  }
+  ReportAllocations(state, scope);
+}
+BENCHMARK(ArticleListStreamBenchmark)->Arg(256)->Arg(16384);
+
+// Decoding a page into owning models copies every text field of every row
+void ArticleListDecodeModelsBenchmark(benchmark::State& state) {
+  const auto rows = MakeArticles(state.range(0));
+  const allocations::Scope scope;
+  for (auto _ : state) {
+    const std::vector<models::ArticleWithAuthorProfile> articles{rows};
+    benchmark::DoNotOptimize(dto::ToArticleListJson(articles));
+  }
+  ReportAllocations(state, scope);
+}
+BENCHMARK(ArticleListDecodeModelsBenchmark)->Arg(256)->Arg(16384);
+
+// Decoding with kRowTag into views leaves the text in the result set
+void ArticleListDecodeViewsBenchmark(benchmark::State& state) {
+  const auto rows = MakeArticles(state.range(0));
+  const allocations::Scope scope;
+  for (auto _ : state) {
+    const auto views = MakeViews(rows);
+    benchmark::DoNotOptimize(dto::ToArticleListJson(views));
+  }
+  ReportAllocations(state, scope);
+}
+BENCHMARK(ArticleListDecodeViewsBenchmark)->Arg(256)->Arg(16384);
+
+// How HttpHandlerJsonBase and the former ParseRequest read the body
+void NewArticleRequestDomBenchmark(benchmark::State& state) {
+  const auto body = MakeNewArticleBody(state.range(0));
+  for (auto _ : state) {
+    const auto json = userver::formats::json::FromString(body);
+    const auto& data = json["article"];
+    dto::NewArticleRequest request;
+    request.title_ = data["title"].As<std::string>();
+    utils::CheckLength(request.title_, "title", 3, 256);
+    request.description_ = data["description"].As<std::string>();
+    utils::CheckLength(request.description_, "description", 5, 8192);
+    request.body_ = data["body"].As<std::string>();
+    utils::CheckLength(request.body_, "body", 5, 65535);
+    request.tag_list_ =
+        data["tagList"].As<std::optional<std::vector<std::string>>>();
+    benchmark::DoNotOptimize(request);
+  }
+}
+BENCHMARK(NewArticleRequestDomBenchmark)->Arg(256)->Arg(60000);
+
+void NewArticleRequestParseBenchmark(benchmark::State& state) {
+  const auto body = MakeNewArticleBody(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dto::NewArticleRequest::Parse(body));
+  }
+}
+BENCHMARK(NewArticleRequestParseBenchmark)->Arg(256)->Arg(60000);
+
+}  // namespace realworld
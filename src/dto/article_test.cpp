@@ -0,0 +1,221 @@
+#include "article.hpp"
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utest/utest.hpp>
+#include "comment.hpp"
+#include "common/errors.hpp"
+
+namespace realworld {
+
+namespace {
+
+const std::chrono::system_clock::time_point kCreatedAt{
+    std::chrono::seconds{1700000000} + std::chrono::microseconds{123456}};
+
+models::Profile MakeProfile(bool with_optionals) {
+  models::Profile profile;
+  profile.username_ = "jake";
+  if (with_optionals) {
+    profile.bio_ = "I work at \"statefarm\"\n";
+    profile.image_ = "https://i.stack.imgur.com/xHWG8.jpg";
+  }
+  profile.following_ = with_optionals;
+  return profile;
+}
+
+std::vector<models::ArticleWithAuthorProfile> MakeArticles() {
+  std::vector<models::ArticleWithAuthorProfile> articles(3);
+  for (std::size_t i = 0; i < articles.size(); ++i) {
+    auto& article = articles[i];
+    article.article_id_ = static_cast<int>(i);
+    article.title_ = "How to train your dragon " + std::to_string(i);
+    article.slug_ = "how-to-train-your-dragon-" + std::to_string(i);
+    article.description_ = "Ever wonder how?\t\\ Привет, 世界";
+    article.body_ = std::string(1000, 'x') + "</script>\u0001";
+    article.created_at_ = kCreatedAt;
+    article.updated_at_ = kCreatedAt + std::chrono::hours{i};
+    article.favorited_ = i % 2;
+    article.favorites_count_ = static_cast<std::int64_t>(i * 1000);
+    article.author_ = MakeProfile(i % 2);
+  }
+  articles[0].tag_list_ = std::vector<std::string>{"dragons", "training"};
+  articles[1].tag_list_ = std::vector<std::string>{};
+  return articles;
+}
+
+// What reading the same row with kRowTag gives
+models::ArticleWithAuthorProfileView MakeView(
+    const models::ArticleWithAuthorProfile& article) {
+  models::ArticleWithAuthorProfileView view{};
+  view.article_id_ = article.article_id_;
+  view.title_ = db::TextView{article.title_};
+  view.slug_ = db::TextView{article.slug_};
+  view.description_ = db::TextView{article.description_};
+  view.body_ = db::TextView{article.body_};
+  view.created_at_ = article.created_at_;
+  view.updated_at_ = article.updated_at_;
+  view.favorited_ = article.favorited_;
+  view.favorites_count_ = article.favorites_count_;
+  view.author_ = article.author_;
+  if (article.tag_list_) {
+    view.tag_list_.emplace();
+    for (const auto& tag : *article.tag_list_) {
+      view.tag_list_->push_back(db::TextView{tag});
+    }
+  }
+  return view;
+}
+
+}  // namespace
+
+UTEST(WriteToStream, ArticleList) {
+  const auto articles = MakeArticles();
+  userver::formats::json::ValueBuilder builder;
+  builder["articles"] = userver::formats::common::Type::kArray;
+  for (const auto& article : articles) {
+    builder["articles"].PushBack(dto::Article::Parse(article));
+  }
+  builder["articlesCount"] = articles.size();
+  EXPECT_EQ(dto::ToArticleListJson(articles),
+            userver::formats::json::ToString(builder.ExtractValue()));
+
+  const std::vector<models::ArticleWithAuthorProfile> no_articles;
+  EXPECT_EQ(dto::ToArticleListJson(no_articles),
+            R"({"articles":[],"articlesCount":0})");
+}
+
+UTEST(WriteToStream, ArticleListView) {
+  const auto articles = MakeArticles();
+  std::vector<models::ArticleWithAuthorProfileView> views;
+  for (const auto& article : articles) {
+    views.push_back(MakeView(article));
+  }
+  EXPECT_EQ(dto::ToArticleListJson(views), dto::ToArticleListJson(articles));
+}
+
+UTEST(WriteToStream, ArticleListFollowing) {
+  auto articles = MakeArticles();
+  std::vector<models::ArticleWithAuthorProfileView> views;
+  std::vector<bool> following;
+  for (const auto& article : articles) {
+    views.push_back(MakeView(article));
+    following.push_back(!article.author_.following_);
+  }
+  const auto json = dto::ToArticleListJson(views, std::nullopt, following);
+  for (std::size_t i = 0; i < articles.size(); ++i) {
+    articles[i].author_.following_ = following[i];
+  }
+  EXPECT_EQ(json, dto::ToArticleListJson(articles));
+}
+
+UTEST(WriteToStream, ArticleListNextCursor) {
+  const auto articles = MakeArticles();
+  const auto page_limit = static_cast<std::int32_t>(articles.size());
+  const auto full_page = userver::formats::json::FromString(
+      dto::ToArticleListJson(articles, page_limit));
+  EXPECT_EQ(full_page["articlesCount"].As<std::size_t>(), articles.size());
+  const auto cursor =
+      pagination::ParseCursor(full_page["nextCursor"].As<std::string>());
+  EXPECT_EQ(cursor.created_at_, articles.back().created_at_);
+  EXPECT_EQ(cursor.id_, articles.back().article_id_);
+
+  // A short page is the last one
+  const auto last_page = userver::formats::json::FromString(
+      dto::ToArticleListJson(articles, page_limit + 1));
+  EXPECT_TRUE(last_page["nextCursor"].IsNull());
+  const std::vector<models::ArticleWithAuthorProfile> no_articles;
+  EXPECT_EQ(dto::ToArticleListJson(no_articles, 20),
+            R"({"articles":[],"articlesCount":0,"nextCursor":null})");
+}
+
+UTEST(WriteToStream, Article) {
+  for (const auto& article : MakeArticles()) {
+    userver::formats::json::ValueBuilder builder;
+    builder["article"] = dto::Article::Parse(article);
+    EXPECT_EQ(dto::ToArticleJson(article),
+              userver::formats::json::ToString(builder.ExtractValue()));
+  }
+}
+
+UTEST(WriteToStream, ArticleWithViewerFlags) {
+  for (auto article : MakeArticles()) {
+    const models::ArticleViewerFlags flags{!article.favorited_,
+                                           !article.author_.following_};
+    const auto json = dto::ToArticleJson(article, flags);
+    article.favorited_ = flags.favorited_;
+    article.author_.following_ = flags.following_;
+    EXPECT_EQ(json, dto::ToArticleJson(article));
+  }
+}
+
+UTEST(WriteToStream, CommentList) {
+  std::vector<models::Comment> comments(2);
+  for (std::size_t i = 0; i < comments.size(); ++i) {
+    comments[i].comment_id = static_cast<int>(i + 1);
+    comments[i].created_at = kCreatedAt;
+    comments[i].updated_at_ = kCreatedAt + std::chrono::minutes{i};
+    comments[i].body_ = "Thank you so much! \"Quoted\" é";
+    comments[i].author_ = MakeProfile(i % 2);
+  }
+  userver::formats::json::ValueBuilder builder;
+  for (const auto& comment : comments) {
+    builder["comments"].PushBack(dto::Comment::Parse(comment));
+  }
+  EXPECT_EQ(dto::ToCommentListJson(comments),
+            userver::formats::json::ToString(builder.ExtractValue()));
+
+  std::vector<models::CommentView> views;
+  for (const auto& comment : comments) {
+    views.push_back({comment.comment_id, comment.created_at,
+                     comment.updated_at_, db::TextView{comment.body_},
+                     comment.author_, comment.comment_id});
+  }
+  EXPECT_EQ(dto::ToCommentListJson(views), dto::ToCommentListJson(comments));
+
+  // The flags of the follow graph replace the ones of the rows
+  const std::vector<bool> following{true, false};
+  const auto json = dto::ToCommentListJson(views, std::nullopt, following);
+  for (std::size_t i = 0; i < comments.size(); ++i) {
+    comments[i].author_.following_ = following[i];
+  }
+  EXPECT_EQ(json, dto::ToCommentListJson(comments));
+}
+
+UTEST(NewArticleRequest, Parse) {
+  const auto request = dto::NewArticleRequest::Parse(
+      R"({"article": {"title": "How to train", "description": "Ever wonder",)"
+      R"( "body": "You have to\nbelieve", "tagList": ["Dragons", "AI"],)"
+      R"( "unknown": {"nested": [1, 2]}}})");
+  EXPECT_EQ(request.title_, "How to train");
+  EXPECT_EQ(request.description_, "Ever wonder");
+  EXPECT_EQ(request.body_, "You have to\nbelieve");
+  ASSERT_TRUE(request.tag_list_);
+  EXPECT_EQ(*request.tag_list_, (std::vector<std::string>{"dragons", "ai"}));
+}
+
+UTEST(NewArticleRequest, ParseErrors) {
+  const auto expect_error = [](std::string_view body,
+                               std::string_view expected_body) {
+    try {
+      dto::NewArticleRequest::Parse(body);
+      ADD_FAILURE() << body;
+    } catch (const errors::ValidationError& ex) {
+      EXPECT_EQ(ex.GetExternalErrorBody(), expected_body) << body;
+    }
+  };
+  expect_error(R"({"article": {"title": "How to train"}})",
+               R"({"errors":{"description":["required"]}})");
+  expect_error(R"({"article": {"title": 1}})",
+               R"({"errors":{"title":["must be a string"]}})");
+  expect_error(R"({"article": {"title": "ab"}})",
+               R"({"errors":{"title":["must be longer than 3 characters)"
+               R"( and less than 256"]}})");
+  expect_error(R"({"article": {"tagList": "dragons"}})",
+               R"({"errors":{"tagList":["must be an array of strings"]}})");
+  expect_error(R"({"article": []})",
+               R"({"errors":{"article":["must be an object"]}})");
+  EXPECT_THROW(dto::NewArticleRequest::Parse(R"({"article": {)"),
+               errors::MalformedRequestError);
+}
+
+}  // namespace realworld
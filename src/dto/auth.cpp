@@ -0,0 +1,58 @@
+#include "auth.hpp"
+#include "common/utils.hpp"
+
+namespace realworld::dto {
+
+RegistrationRequest RegistrationRequest::Parse(std::string_view request_body) {
+  RegistrationRequest request;
+  bool has_username{false};
+  bool has_password{false};
+  bool has_email{false};
+  utils::ReadRequestObject(
+      request_body, "user", [&](json::Reader& reader, std::string_view key) {
+        if (key == "username") {
+          request.username_ = utils::ReadString(reader, key);
+          utils::CheckLength(request.username_, key, 2, 20);
+          has_username = true;
+        } else if (key == "password") {
+          request.password_ = utils::ReadString(reader, key);
+          utils::CheckLength(request.password_, key, 5, 100);
+          has_password = true;
+        } else if (key == "email") {
+          request.email_ = utils::ReadString(reader, key);
+          utils::CheckEmail(request.email_, key);
+          has_email = true;
+        } else {
+          reader.Skip();
+        }
+      });
+  utils::CheckRequired(has_username, "username");
+  utils::CheckRequired(has_password, "password");
+  utils::CheckRequired(has_email, "email");
+  return request;
+}
+
+LoginRequest LoginRequest::Parse(std::string_view request_body) {
+  LoginRequest request;
+  bool has_email{false};
+  bool has_password{false};
+  utils::ReadRequestObject(
+      request_body, "user", [&](json::Reader& reader, std::string_view key) {
+        if (key == "email") {
+          request.email_ = utils::ReadString(reader, key);
+          utils::CheckEmail(request.email_, key);
+          has_email = true;
+        } else if (key == "password") {
+          request.password_ = utils::ReadString(reader, key);
+          utils::CheckLength(request.password_, key, 5, 100);
+          has_password = true;
+        } else {
+          reader.Skip();
+        }
+      });
+  utils::CheckRequired(has_email, "email");
+  utils::CheckRequired(has_password, "password");
+  return request;
+}
+
+}  // namespace realworld::dto
@@ -1,15 +1,26 @@
 #pragma once
+
+#include <string>
+#include <string_view>
 #include "userver/formats/json/value.hpp"
 
 namespace realworld::dto {
 
 struct RegistrationRequest final {
+  // Parses and validates a {"user": {...}} body, throws
+  // errors::ValidationError
+  static RegistrationRequest Parse(std::string_view request_body);
+
   std::string username_;
   std::string password_;
   std::string email_;
 };
 
 struct LoginRequest final {
+  // Parses and validates a {"user": {...}} body, throws
+  // errors::ValidationError
+  static LoginRequest Parse(std::string_view request_body);
+
   std::string email_;
   std::string password_;
 };
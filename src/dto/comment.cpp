@@ -1,7 +1,29 @@
 #include "comment.hpp"
+#include "common/utils.hpp"
 
 namespace realworld::dto {
 
+namespace {
+
+// Shared by the owning models and the views over a result set
+template <typename Model>
+void WriteComment(const Model& comment, bool following,
+                  userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("id");
+  sw.WriteInt64(comment.comment_id);
+  sw.Key("createdAt");
+  userver::formats::json::WriteToStream(comment.created_at, sw);
+  sw.Key("updatedAt");
+  userver::formats::json::WriteToStream(comment.updated_at_, sw);
+  sw.Key("body");
+  sw.WriteString(comment.body_);
+  sw.Key("author");
+  WriteToStream(comment.author_, following, sw);
+}
+
+}  // namespace
+
 Comment Comment::Parse(const models::Comment& model) {
   Comment comment;
   comment.body_ = model.body_;
@@ -27,4 +49,52 @@ userver::formats::json::Value Serialize(
   return builder.ExtractValue();
 }
 
+void WriteToStream(const models::Comment& comment,
+                   userver::formats::json::StringBuilder& sw) {
+  WriteComment(comment, comment.author_.following_, sw);
+}
+
+void WriteToStream(const models::CommentView& comment,
+                   userver::formats::json::StringBuilder& sw) {
+  WriteComment(comment, comment.author_.following_, sw);
+}
+
+void WriteToStream(const models::Comment& comment, bool following,
+                   userver::formats::json::StringBuilder& sw) {
+  WriteComment(comment, following, sw);
+}
+
+void WriteToStream(const models::CommentView& comment, bool following,
+                   userver::formats::json::StringBuilder& sw) {
+  WriteComment(comment, following, sw);
+}
+
+std::string ToCommentJson(const models::Comment& comment) {
+  userver::formats::json::StringBuilder sw;
+  {
+    userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+    sw.Key("comment");
+    WriteToStream(comment, sw);
+  }
+  return sw.GetString();
+}
+
+NewCommentRequest NewCommentRequest::Parse(std::string_view request_body) {
+  NewCommentRequest request;
+  bool has_body{false};
+  utils::ReadRequestObject(
+      request_body, "comment",
+      [&](json::Reader& reader, std::string_view key) {
+        if (key == "body") {
+          request.body_ = utils::ReadString(reader, key);
+          utils::CheckLength(request.body_, key, 4, 16384);
+          has_body = true;
+        } else {
+          reader.Skip();
+        }
+      });
+  utils::CheckRequired(has_body, "body");
+  return request;
+}
+
 }  // namespace realworld::dto
\ No newline at end of file
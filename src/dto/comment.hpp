@@ -2,9 +2,13 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "common/pagination.hpp"
 #include "models/comment.hpp"
 #include "profile.hpp"
 #include "userver/formats/json.hpp"
+#include "userver/formats/json/string_builder.hpp"
 
 namespace realworld::dto {
 
@@ -22,7 +26,64 @@ userver::formats::json::Value Serialize(
     const Comment& Comment,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+// Writes the same JSON as Serialize(Comment::Parse(comment)) without the
+// intermediate copies
+void WriteToStream(const models::Comment& comment,
+                   userver::formats::json::StringBuilder& sw);
+void WriteToStream(const models::CommentView& comment,
+                   userver::formats::json::StringBuilder& sw);
+// The same with following in place of comment.author_.following_
+void WriteToStream(const models::Comment& comment, bool following,
+                   userver::formats::json::StringBuilder& sw);
+void WriteToStream(const models::CommentView& comment, bool following,
+                   userver::formats::json::StringBuilder& sw);
+
+// {"comment": {...}}
+std::string ToCommentJson(const models::Comment& comment);
+
+// {"comments": [...]}, comments is any range of models::Comment(View). With
+// a page_limit "nextCursor" is added, and a non-empty following replaces
+// the author flags, as in ToArticleListJson.
+template <typename Comments>
+std::string ToCommentListJson(
+    const Comments& comments,
+    std::optional<std::int32_t> page_limit = std::nullopt,
+    const std::vector<bool>& following = {}) {
+  userver::formats::json::StringBuilder sw;
+  {
+    userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+    std::size_t count{0};
+    pagination::Cursor last;
+    sw.Key("comments");
+    {
+      userver::formats::json::StringBuilder::ArrayGuard array_guard{sw};
+      for (const auto& comment : comments) {
+        if (following.empty()) {
+          WriteToStream(comment, sw);
+        } else {
+          WriteToStream(comment, following[count], sw);
+        }
+        last = {comment.created_at, comment.comment_id};
+        ++count;
+      }
+    }
+    if (page_limit) {
+      sw.Key("nextCursor");
+      if (count > 0 && count == static_cast<std::size_t>(*page_limit)) {
+        sw.WriteString(pagination::EncodeCursor(last));
+      } else {
+        sw.WriteNull();
+      }
+    }
+  }
+  return sw.GetString();
+}
+
 struct NewCommentRequest final {
+  // Parses and validates a {"comment": {...}} body, the slug and the user
+  // are left empty
+  static NewCommentRequest Parse(std::string_view request_body);
+
   std::string body_;
   std::string slug_;
   std::int32_t user_id_;
@@ -21,4 +21,30 @@ userver::formats::json::Value Serialize(
   return builder.ExtractValue();
 }
 
+void WriteToStream(const models::Profile& profile,
+                   userver::formats::json::StringBuilder& sw) {
+  WriteToStream(profile, profile.following_, sw);
+}
+
+void WriteToStream(const models::Profile& profile, bool following,
+                   userver::formats::json::StringBuilder& sw) {
+  userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+  sw.Key("username");
+  sw.WriteString(profile.username_);
+  sw.Key("bio");
+  if (profile.bio_) {
+    sw.WriteString(*profile.bio_);
+  } else {
+    sw.WriteNull();
+  }
+  sw.Key("image");
+  if (profile.image_) {
+    sw.WriteString(*profile.image_);
+  } else {
+    sw.WriteNull();
+  }
+  sw.Key("following");
+  sw.WriteBool(following);
+}
+
 }  // namespace realworld::dto
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include <optional>
 #include <string>
+#include "models/profile.hpp"
 #include "userver/formats/json.hpp"
+#include "userver/formats/json/string_builder.hpp"
 
 namespace realworld::dto {
 
@@ -17,4 +19,11 @@ userver::formats::json::Value Serialize(
     const Profile& data,
     userver::formats::serialize::To<userver::formats::json::Value>);
 
+// Writes the same JSON as Serialize(Profile) straight from the model
+void WriteToStream(const models::Profile& profile,
+                   userver::formats::json::StringBuilder& sw);
+// The same with following in place of profile.following_
+void WriteToStream(const models::Profile& profile, bool following,
+                   userver::formats::json::StringBuilder& sw);
+
 }  // namespace realworld::dto
\ No newline at end of file
@@ -1,25 +1,72 @@
 #include "user.hpp"
+#include "common/utils.hpp"
+#include "userver/formats/json/string_builder.hpp"
 
 namespace realworld::dto {
 
-userver::formats::json::Value Serialize(
-    const User& data,
-    userver::formats::serialize::To<userver::formats::json::Value>) {
-  userver::formats::json::ValueBuilder builder;
-  builder["email"] = data.email_;
-  builder["token"] = data.token_;
-  builder["username"] = data.username_;
-  if (data.bio_) {
-    builder["bio"] = *data.bio_;
-  } else {
-    builder["bio"] = userver::formats::common::Type::kNull;
+std::string ToUserJson(const User& user) {
+  userver::formats::json::StringBuilder sw;
+  {
+    userver::formats::json::StringBuilder::ObjectGuard guard{sw};
+    sw.Key("user");
+    userver::formats::json::StringBuilder::ObjectGuard user_guard{sw};
+    sw.Key("email");
+    sw.WriteString(user.email_);
+    sw.Key("token");
+    sw.WriteString(user.token_);
+    sw.Key("username");
+    sw.WriteString(user.username_);
+    sw.Key("bio");
+    if (user.bio_) {
+      sw.WriteString(*user.bio_);
+    } else {
+      sw.WriteNull();
+    }
+    sw.Key("image");
+    if (user.image_) {
+      sw.WriteString(*user.image_);
+    } else {
+      sw.WriteNull();
+    }
   }
-  if (data.image_) {
-    builder["image"] = *data.image_;
-  } else {
-    builder["image"] = userver::formats::common::Type::kNull;
+  return sw.GetString();
+}
+
+UpdateUserRequest UpdateUserRequest::Parse(std::string_view request_body) {
+  UpdateUserRequest request;
+  utils::ReadRequestObject(
+      request_body, "user",
+      [&request](json::Reader& reader, std::string_view key) {
+        const auto read_checked = [&reader, key](int min, int max) {
+          auto value = utils::ReadOptionalString(reader, key);
+          if (value) {
+            utils::CheckLength(*value, key, min, max);
+          }
+          return value;
+        };
+        if (key == "email") {
+          request.email_ = utils::ReadOptionalString(reader, key);
+          if (request.email_) {
+            utils::CheckEmail(*request.email_, key);
+          }
+        } else if (key == "username") {
+          request.username_ = read_checked(2, 20);
+        } else if (key == "password") {
+          request.password_ = read_checked(5, 100);
+        } else if (key == "bio") {
+          request.bio_ = read_checked(3, 65535);
+        } else if (key == "image") {
+          request.image_ = read_checked(3, 255);
+        } else {
+          reader.Skip();
+        }
+      });
+  if (!request.email_ && !request.username_ && !request.password_ &&
+      !request.bio_ && !request.image_) {
+    throw errors::ValidationError{
+        errors::ErrorBuilder{"user", "cannot be empty"}};
   }
-  return builder.ExtractValue();
+  return request;
 }
 
 }  // namespace realworld::dto
\ No newline at end of file
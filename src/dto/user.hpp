@@ -2,8 +2,8 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include "models/user.hpp"
-#include "userver/formats/json.hpp"
 
 namespace realworld::dto {
 
@@ -15,11 +15,14 @@ struct User final {
   std::optional<std::string> image_{};
 };
 
-userver::formats::json::Value Serialize(
-    const User& data,
-    userver::formats::serialize::To<userver::formats::json::Value>);
+// {"user": {...}}
+std::string ToUserJson(const User& user);
 
 struct UpdateUserRequest final {
+  // Parses and validates a {"user": {...}} body, throws
+  // errors::ValidationError
+  static UpdateUserRequest Parse(std::string_view request_body);
+
   std::optional<std::string> email_;
   std::optional<std::string> username_;
   std::optional<std::string> password_;
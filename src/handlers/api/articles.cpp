@@ -3,6 +3,7 @@
 #include "bcrypt/BCrypt.hpp"
 #include "common/auth.hpp"
 #include "common/errors.hpp"
+#include "common/pagination.hpp"
 #include "common/utils.hpp"
 #include "db/sql.hpp"
 #include "dto/article.hpp"
@@ -30,13 +31,7 @@ dto::ArticlesListRequest ParseRequest(
   if (request.HasArg("author")) {
     filters.author_ = request.GetArg("author");
   }
-  if (request.HasArg("limit")) {
-    filters.limit_ = boost::lexical_cast<std::int32_t>(request.GetArg("limit"));
-  }
-  if (request.HasArg("offset")) {
-    filters.offset_ =
-        boost::lexical_cast<std::int32_t>(request.GetArg("offset"));
-  }
+  filters.page_ = pagination::ParsePage(request);
   return filters;
 }
 
@@ -44,19 +39,22 @@ dto::ArticlesListRequest ParseRequest(
 
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      follow_graph_(context.FindComponent<components::FollowGraph>()),
+      allocation_statistics_(
+          context.FindComponent<components::AllocationStatistics>()
+              .GetEndpoint(kName)) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   const auto filters = ParseRequest(request);
-  const auto* user_auth_data =
-      request_context.GetDataOptional<auth::UserAuthData>("user_auth_data");
+  const auto* user_auth_data = auth::GetUserAuthDataOptional(request_context);
   const auto user_id =
       user_auth_data ? std::make_optional<std::int32_t>(user_auth_data->id_)
                      : std::nullopt;
@@ -64,68 +62,47 @@ userver::formats::json::Value Handler::HandleRequestJsonThrow(
       cluster_->Execute(userver::storages::postgres::ClusterHostType::kSlave,
                         db::sql::kGetArticlesWithAuthorProfile.data(),
                         filters.tag_, filters.author_, filters.favorited_,
-                        user_id, filters.limit_, filters.offset_);
-  const auto list_articles = res.AsSetOf<models::ArticleWithAuthorProfile>();
-  userver::formats::json::ValueBuilder builder;
-  builder["articles"] = userver::formats::common::Type::kArray;
-  std::for_each(list_articles.begin(), list_articles.end(),
-                [&builder](const auto& article) {
-                  builder["articles"].PushBack(dto::Article::Parse(article));
-                });
-  builder["articlesCount"] = list_articles.Size();
-  return builder.ExtractValue();
+                        user_id, filters.page_.limit_, filters.page_.offset_,
+                        filters.page_.CursorCreatedAt(),
+                        filters.page_.CursorId());
+  // One lock of the viewer's shard for the whole page
+  const auto following = follow_graph_.AreAuthorsFollowed(user_id, res);
+  // Rows are decoded while being serialized, neither suspends
+  const allocations::Scope allocations;
+  auto body = dto::ToArticleListJson(
+      res.AsSetOf<models::ArticleWithAuthorProfileView>(
+          userver::storages::postgres::kRowTag),
+      filters.page_.limit_, following);
+  allocation_statistics_.Account(allocations.Get());
+  return body;
 }
 
 }  // namespace get
 
 namespace post {
 
-namespace {
-
-dto::NewArticleRequest ParseRequest(const userver::formats::json::Value& data) {
-  dto::NewArticleRequest new_article_request;
-  new_article_request.title_ = utils::CheckSize(data, "title", 3, 256);
-  new_article_request.description_ =
-      utils::CheckSize(data, "description", 5, 8192);
-  new_article_request.body_ = utils::CheckSize(data, "body", 5, 65535);
-  new_article_request.tag_list_ =
-      data["tagList"].As<std::optional<std::vector<std::string>>>();
-  if (new_article_request.tag_list_) {
-    std::for_each(new_article_request.tag_list_->begin(),
-                  new_article_request.tag_list_->end(), [](auto& tag) {
-                    utils::CheckSize(tag, "tagList", 2, 256);
-                    boost::algorithm::to_lower(tag);
-                  });
-  }
-  return new_article_request;
-}
-
-}  // namespace
-
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
                    .GetCluster()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value& request_json,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   dto::NewArticleRequest new_article_request;
   try {
-    new_article_request = ParseRequest(request_json["article"]);
+    new_article_request = dto::NewArticleRequest::Parse(request.RequestBody());
   } catch (const errors::ValidationError& ex) {
     request.SetResponseStatus(
         userver::server::http::HttpStatus::kUnprocessableEntity);
-    return ex.ToJson();
+    return ex.GetExternalErrorBody();
   }
-  const auto& user_auth_data =
-      request_context.GetData<auth::UserAuthData>("user_auth_data");
+  const auto& user_auth_data = auth::GetUserAuthData(request_context);
 
-  std::int32_t article_id{};
   try {
     const auto slug = slug::Slugify(new_article_request.title_);
     const auto res = cluster_->Execute(
@@ -133,26 +110,18 @@ userver::formats::json::Value Handler::HandleRequestJsonThrow(
         db::sql::kAddNewArticle.data(), new_article_request.title_, slug,
         new_article_request.description_, new_article_request.body_,
         user_auth_data.id_, new_article_request.tag_list_);
-
-    article_id = res.AsSingleRow<std::int32_t>();
+    return dto::ToArticleJson(
+        res.AsSingleRow<models::ArticleWithAuthorProfile>());
   } catch (const userver::storages::postgres::UniqueViolation& ex) {
     const auto constraint = ex.GetServerMessage().GetConstraint();
     if (constraint == "uniq_slug") {
       request.SetResponseStatus(
           userver::server::http::HttpStatus::kUnprocessableEntity);
-      return errors::MakeError("slug", "has already been taken");
+      return errors::ErrorBuilder{"slug", "has already been taken"}
+          .GetExternalBody();
     }
     throw;
   }
-  const auto res =
-      cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                        db::sql::kGetArticleWithAuthorProfile.data(),
-                        article_id, user_auth_data.id_);
-
-  userver::formats::json::ValueBuilder builder;
-  builder["article"] =
-      dto::Article::Parse(res.AsSingleRow<models::ArticleWithAuthorProfile>());
-  return builder.ExtractValue();
 }
 
 }  // namespace post
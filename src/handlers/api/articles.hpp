@@ -1,9 +1,11 @@
 #pragma once
 
 #include "common/slugify.hpp"
+#include "components/allocation_statistics.hpp"
+#include "components/follow_graph.hpp"
+#include "handlers/json_response_handler_base.hpp"
 #include "userver/components/component_context.hpp"
 #include "userver/formats/json/value.hpp"
-#include "userver/server/handlers/http_handler_base.hpp"
 #include "userver/server/handlers/http_handler_json_base.hpp"
 #include "userver/storages/postgres/postgres_fwd.hpp"
 
@@ -11,37 +13,37 @@ namespace realworld::handlers::api::articles {
 
 namespace get {
 
-class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
+class Handler final : public JsonResponseHandlerBase {
  public:
   static constexpr std::string_view kName{"handler-get-api-articles"};
 
   Handler(const userver::components::ComponentConfig& config,
           const userver::components::ComponentContext& context);
 
-  userver::formats::json::Value HandleRequestJsonThrow(
+  std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
-      const userver::formats::json::Value&,
       userver::server::request::RequestContext& request_context)
       const override final;
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
+  const components::FollowGraph& follow_graph_;
+  const components::AllocationStatistics::Endpoint& allocation_statistics_;
 };
 
 }  // namespace get
 
 namespace post {
 
-class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
+class Handler final : public JsonResponseHandlerBase {
  public:
   static constexpr std::string_view kName{"handler-post-api-articles"};
 
   Handler(const userver::components::ComponentConfig& config,
           const userver::components::ComponentContext& context);
 
-  userver::formats::json::Value HandleRequestJsonThrow(
+  std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
-      const userver::formats::json::Value&,
       userver::server::request::RequestContext& request_context)
       const override final;
 
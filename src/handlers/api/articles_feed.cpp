@@ -2,6 +2,7 @@
 #include "bcrypt/BCrypt.hpp"
 #include "common/auth.hpp"
 #include "common/errors.hpp"
+#include "common/pagination.hpp"
 #include "common/utils.hpp"
 #include "db/sql.hpp"
 #include "dto/article.hpp"
@@ -19,13 +20,7 @@ namespace {
 dto::FeedRequest ParseRequest(
     const userver::server::http::HttpRequest& request) {
   dto::FeedRequest filters;
-  if (request.HasArg("limit")) {
-    filters.limit_ = boost::lexical_cast<std::int32_t>(request.GetArg("limit"));
-  }
-  if (request.HasArg("offset")) {
-    filters.offset_ =
-        boost::lexical_cast<std::int32_t>(request.GetArg("offset"));
-  }
+  filters.page_ = pagination::ParsePage(request);
   return filters;
 }
 
@@ -33,32 +28,38 @@ dto::FeedRequest ParseRequest(
 
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      follow_graph_(context.FindComponent<components::FollowGraph>()),
+      allocation_statistics_(
+          context.FindComponent<components::AllocationStatistics>()
+              .GetEndpoint(kName)) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   const auto filters = ParseRequest(request);
+  const auto user_id = auth::GetUserAuthData(request_context).id_;
   const auto res = cluster_->Execute(
       userver::storages::postgres::ClusterHostType::kSlave,
-      db::sql::kGetFeed.data(),
-      request_context.GetData<auth::UserAuthData>("user_auth_data").id_,
-      filters.limit_, filters.offset_);
-  const auto list_articles = res.AsSetOf<models::ArticleWithAuthorProfile>();
-
-  userver::formats::json::ValueBuilder builder;
-  builder["articles"] = userver::formats::common::Type::kArray;
-  std::for_each(list_articles.begin(), list_articles.end(),
-                [&builder](const auto& article) {
-                  builder["articles"].PushBack(dto::Article::Parse(article));
-                });
-  builder["articlesCount"] = list_articles.Size();
-  return builder.ExtractValue();
+      db::sql::kGetFeed.data(), user_id, filters.page_.limit_,
+      filters.page_.offset_, filters.page_.CursorCreatedAt(),
+      filters.page_.CursorId());
+  // The timeline can still hold authors unfollowed since, the graph has the
+  // current flags
+  const auto following = follow_graph_.AreAuthorsFollowed(user_id, res);
+  // Rows are decoded while being serialized, neither suspends
+  const allocations::Scope allocations;
+  auto body = dto::ToArticleListJson(
+      res.AsSetOf<models::ArticleWithAuthorProfileView>(
+          userver::storages::postgres::kRowTag),
+      filters.page_.limit_, following);
+  allocation_statistics_.Account(allocations.Get());
+  return body;
 }
 
 }  // namespace realworld::handlers::api::articles_feed::get
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "common/auth.hpp"
 #include "common/errors.hpp"
 #include "common/utils.hpp"
+#include "components/article_cache.hpp"
 #include "db/sql.hpp"
 #include "dto/article.hpp"
 #include "models/article.hpp"
@@ -19,102 +20,90 @@ namespace get {
 
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      article_cache_(
+          context.FindComponent<components::ArticleCache>().GetCache()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   const auto& slug = request.GetPathArg("slug");
-  const auto* user_auth_data =
-      request_context.GetDataOptional<auth::UserAuthData>("user_auth_data");
+  const auto* user_auth_data = auth::GetUserAuthDataOptional(request_context);
   const auto user_id =
       user_auth_data ? std::make_optional<std::int32_t>(user_auth_data->id_)
                      : std::nullopt;
-  const auto res = cluster_->Execute(
-      userver::storages::postgres::ClusterHostType::kSlave,
-      db::sql::kGetArticleWithAuthorProfileBySlug.data(), slug, user_id);
+  if (const auto article = article_cache_.Get(slug)) {
+    if (!user_id) {
+      return dto::ToArticleJson(*article);
+    }
+    const auto res = cluster_->Execute(
+        userver::storages::postgres::ClusterHostType::kSlave,
+        db::sql::kGetArticleViewerFlags.data(), article->article_id_,
+        *user_id);
+    if (res.IsEmpty()) {
+      // Deleted by another process
+      article_cache_.Invalidate(slug);
+      request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
+      return std::string{utils::kNullJson};
+    }
+    return dto::ToArticleJson(
+        *article, res.AsSingleRow<models::ArticleViewerFlags>(
+                      userver::storages::postgres::kRowTag));
+  }
+
+  // A replica may not have the writes of this process yet
+  const auto host_type =
+      article_cache_.IsRecentlyWritten(slug)
+          ? userver::storages::postgres::ClusterHostType::kMaster
+          : userver::storages::postgres::ClusterHostType::kSlave;
+  const auto res =
+      cluster_->Execute(host_type,
+                        db::sql::kGetArticleWithAuthorProfileBySlug.data(),
+                        slug, user_id);
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-    return {};
+    return std::string{utils::kNullJson};
   }
-  userver::formats::json::ValueBuilder builder;
-  builder["article"] =
-      dto::Article::Parse(res.AsSingleRow<models::ArticleWithAuthorProfile>());
-  return builder.ExtractValue();
+  const auto article = res.AsSingleRow<models::ArticleWithAuthorProfile>();
+  article_cache_.Put(article);
+  return dto::ToArticleJson(article);
 }
 
 }  // namespace get
 
 namespace put {
 
-namespace {
-
-dto::UpdateArticleRequest ParseRequest(
-    const userver::formats::json::Value& data,
-    const userver::server::http::HttpRequest& request) {
-  dto::UpdateArticleRequest article;
-  article.slug_ = request.GetPathArg("slug");
-  if (article.title_ = data["title"].As<std::optional<std::string>>();
-      article.title_) {
-    utils::CheckSize(*article.title_, "title", 3, 255);
-  }
-  if (article.description_ =
-          data["description"].As<std::optional<std::string>>();
-      article.description_) {
-    utils::CheckSize(*article.description_, "description", 5, 8192);
-  }
-  if (article.body_ = data["body"].As<std::optional<std::string>>();
-      article.body_) {
-    utils::CheckSize(*article.body_, "body", 5, 65535);
-  }
-  article.tag_list_ =
-      data["tagList"].As<std::optional<std::vector<std::string>>>();
-  if (article.tag_list_) {
-    std::for_each(article.tag_list_->begin(), article.tag_list_->end(),
-                  [](auto& tag) {
-                    utils::CheckSize(tag, "tagList", 2, 256);
-                    boost::algorithm::to_lower(tag);
-                  });
-  }
-  if (!article.title_ && !article.description_ && !article.body_ &&
-      !article.tag_list_) {
-    throw errors::ValidationError{
-        errors::ErrorBuilder{"article", "cannot be empty"}};
-  }
-  return article;
-}
-
-}  // namespace
-
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      article_cache_(
+          context.FindComponent<components::ArticleCache>().GetCache()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value& request_json,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   dto::UpdateArticleRequest update_article_request;
   try {
-    update_article_request = ParseRequest(request_json["article"], request);
+    update_article_request =
+        dto::UpdateArticleRequest::Parse(request.RequestBody());
   } catch (const errors::ValidationError& ex) {
     request.SetResponseStatus(
         userver::server::http::HttpStatus::kUnprocessableEntity);
-    return ex.ToJson();
+    return ex.GetExternalErrorBody();
   }
-  const auto user_auth_data =
-      request_context.GetData<auth::UserAuthData>("user_auth_data");
+  update_article_request.slug_ = request.GetPathArg("slug");
+  const auto& user_auth_data = auth::GetUserAuthData(request_context);
 
-  std::int32_t article_id{};
   try {
     const auto new_slug = update_article_request.title_
                               ? std::make_optional<std::string>(slug::Slugify(
@@ -124,30 +113,34 @@ userver::formats::json::Value Handler::HandleRequestJsonThrow(
         userver::storages::postgres::ClusterHostType::kMaster,
         db::sql::kUpdateArticleBySlug.data(), update_article_request.slug_,
         user_auth_data.id_, update_article_request.title_, new_slug,
-        update_article_request.description_, update_article_request.body_);
+        update_article_request.description_, update_article_request.body_,
+        update_article_request.tag_list_);
     if (res.IsEmpty()) {
       request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-      return {};
+      return std::string{utils::kNullJson};
     }
-    article_id = res.AsSingleRow<std::int32_t>();
+    const auto updated = res.AsSingleRow<models::UpdatedArticle>(
+        userver::storages::postgres::kRowTag);
+    if (!updated.owned_) {
+      throw errors::ForbiddenError{
+          errors::ErrorBuilder{"article", "forbidden"}};
+    }
+    const auto& article = *updated.article_;
+    article_cache_.Invalidate(update_article_request.slug_);
+    if (article.slug_ != update_article_request.slug_) {
+      article_cache_.Invalidate(article.slug_);
+    }
+    return dto::ToArticleJson(article);
   } catch (const userver::storages::postgres::UniqueViolation& ex) {
     const auto constraint = ex.GetServerMessage().GetConstraint();
     if (constraint == "uniq_slug") {
       request.SetResponseStatus(
           userver::server::http::HttpStatus::kUnprocessableEntity);
-      return errors::MakeError("slug", "has already been taken");
+      return errors::ErrorBuilder{"slug", "has already been taken"}
+          .GetExternalBody();
     }
     throw;
   }
-  const auto res =
-      cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                        db::sql::kGetArticleWithAuthorProfile.data(),
-                        article_id, user_auth_data.id_);
-
-  userver::formats::json::ValueBuilder builder;
-  builder["article"] =
-      dto::Article::Parse(res.AsSingleRow<models::ArticleWithAuthorProfile>());
-  return builder.ExtractValue();
 }
 
 }  // namespace put
@@ -160,24 +153,27 @@ Handler::Handler(const userver::components::ComponentConfig& config,
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      article_cache_(
+          context.FindComponent<components::ArticleCache>().GetCache()) {}
 
 userver::formats::json::Value Handler::HandleRequestJsonThrow(
     const userver::server::http::HttpRequest& request,
     const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
   const auto& slug = request.GetPathArg("slug");
-  const auto user_id =
-      request_context.GetData<auth::UserAuthData>("user_auth_data").id_;
+  const auto user_id = auth::GetUserAuthData(request_context).id_;
   const auto res =
       cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                        db::sql::kGetArticleIdBySlug.data(), slug);
+                        db::sql::kDeleteArticleBySlug.data(), slug, user_id);
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
     return {};
   }
-  cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                    db::sql::kDeleteArticleBySlug.data(), slug, user_id);
+  if (!res.AsSingleRow<bool>()) {
+    throw errors::ForbiddenError{errors::ErrorBuilder{"article", "forbidden"}};
+  }
+  article_cache_.Invalidate(slug);
   return {};
 }
 
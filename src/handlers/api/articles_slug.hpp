@@ -1,11 +1,13 @@
 #pragma once
 
+#include <string>
 #include <string_view>
+#include "common/article_cache.hpp"
 #include "common/slugify.hpp"
+#include "handlers/json_response_handler_base.hpp"
 #include "userver/components/component_config.hpp"
 #include "userver/components/component_context.hpp"
 #include "userver/formats/json/value.hpp"
-#include "userver/server/handlers/http_handler_base.hpp"
 #include "userver/server/handlers/http_handler_json_base.hpp"
 #include "userver/storages/postgres/postgres_fwd.hpp"
 
@@ -13,42 +15,42 @@ namespace realworld::handlers::api::articles_slug {
 
 namespace get {
 
-class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
+class Handler final : public JsonResponseHandlerBase {
  public:
   static constexpr std::string_view kName{"handler-get-api-articles-slug"};
 
   Handler(const userver::components::ComponentConfig& config,
           const userver::components::ComponentContext& context);
 
-  userver::formats::json::Value HandleRequestJsonThrow(
+  std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
-      const userver::formats::json::Value&,
       userver::server::request::RequestContext& request_context)
       const override final;
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
+  const articles::ArticleCache& article_cache_;
 };
 
 }  // namespace get
 
 namespace put {
 
-class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
+class Handler final : public JsonResponseHandlerBase {
  public:
   static constexpr std::string_view kName{"handler-put-api-articles-slug"};
 
   Handler(const userver::components::ComponentConfig& config,
           const userver::components::ComponentContext& context);
 
-  userver::formats::json::Value HandleRequestJsonThrow(
+  std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
-      const userver::formats::json::Value&,
       userver::server::request::RequestContext& request_context)
       const override final;
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
+  const articles::ArticleCache& article_cache_;
 };
 
 }  // namespace put
@@ -70,6 +72,7 @@ class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
+  const articles::ArticleCache& article_cache_;
 };
 
 }  // namespace del
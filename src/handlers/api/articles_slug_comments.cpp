@@ -1,7 +1,10 @@
 #include "articles_slug_comments.hpp"
+#include <optional>
 #include "bcrypt/BCrypt.hpp"
 #include "common/auth.hpp"
+#include "common/dynamic_config.hpp"
 #include "common/errors.hpp"
+#include "common/pagination.hpp"
 #include "common/utils.hpp"
 #include "db/sql.hpp"
 #include "db/types.hpp"
@@ -9,11 +12,14 @@
 #include "dto/comment.hpp"
 #include "models/article.hpp"
 #include "models/comment.hpp"
+#include "userver/dynamic_config/storage/component.hpp"
+#include "userver/engine/task/task_with_result.hpp"
 #include "userver/formats/json/inline.hpp"
 #include "userver/formats/json/value.hpp"
 #include "userver/formats/yaml/value_builder.hpp"
 #include "userver/storages/postgres/cluster.hpp"
 #include "userver/storages/postgres/component.hpp"
+#include "userver/utils/async.hpp"
 
 namespace realworld::handlers::api::articles_slug_comments {
 
@@ -21,91 +27,103 @@ namespace get {
 
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
-
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+                   .GetCluster()),
+      config_source_(
+          context.FindComponent<userver::components::DynamicConfig>()
+              .GetSource()),
+      follow_graph_(context.FindComponent<components::FollowGraph>()),
+      allocation_statistics_(
+          context.FindComponent<components::AllocationStatistics>()
+              .GetEndpoint(kName)) {}
+
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   const auto& slug = request.GetPathArg("slug");
-  const auto* user_auth_data =
-      request_context.GetDataOptional<auth::UserAuthData>("user_auth_data");
+  const auto* user_auth_data = auth::GetUserAuthDataOptional(request_context);
   const auto user_id =
       user_auth_data ? std::make_optional<std::int32_t>(user_auth_data->id_)
                      : std::nullopt;
-  const auto res =
-      cluster_->Execute(userver::storages::postgres::ClusterHostType::kSlave,
-                        db::sql::kGetCommentsFromArticle.data(), slug, user_id);
-  if (res.IsEmpty()) {
-    return {};
+  // Comments are returned all at once unless the client asks for pages
+  const auto page = pagination::ParsePage(request, pagination::kMaxLimit);
+  const auto limit = request.HasArg("limit") || page.cursor_
+                         ? std::make_optional(page.limit_)
+                         : std::nullopt;
+  const auto read_comments = [&] {
+    return cluster_->Execute(
+        userver::storages::postgres::ClusterHostType::kSlave,
+        db::sql::kGetCommentsFromArticle.data(), slug, limit, page.offset_,
+        page.CursorCreatedAt(), page.CursorId());
+  };
+  // The comments do not wait for the article, so they are read while the
+  // article is looked up. The task is cancelled if there is no article.
+  std::optional<
+      userver::engine::TaskWithResult<userver::storages::postgres::ResultSet>>
+      comments_task;
+  if (config_source_.GetCopy(dynamic_config::kConcurrentQueriesEnabled)) {
+    comments_task = userver::utils::Async("get-comments", read_comments);
   }
-  const auto comments = res.AsSetOf<models::Comment>();
-  userver::formats::json::ValueBuilder builder;
-  std::for_each(comments.begin(), comments.end(),
-                [&builder](const auto& comment) {
-                  builder["comments"].PushBack(dto::Comment::Parse(comment));
-                });
-  return builder.ExtractValue();
+  const auto article = cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kSlave,
+      db::sql::kGetArticleIdBySlug.data(), slug);
+  if (article.IsEmpty()) {
+    request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
+    return std::string{utils::kNullJson};
+  }
+  const auto res = comments_task ? comments_task->Get() : read_comments();
+  if (res.IsEmpty() && !page.cursor_ && page.offset_ == 0) {
+    return std::string{utils::kNullJson};
+  }
+  const auto following = follow_graph_.AreAuthorsFollowed(user_id, res);
+  // Rows are decoded while being serialized, neither suspends
+  const allocations::Scope allocations;
+  auto body = dto::ToCommentListJson(
+      res.AsSetOf<models::CommentView>(userver::storages::postgres::kRowTag),
+      limit, following);
+  allocation_statistics_.Account(allocations.Get());
+  return body;
 }
 
 }  // namespace get
 
 namespace post {
 
-namespace {
-
-dto::NewCommentRequest ParseRequest(
-    const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value& request_json,
-    userver::server::request::RequestContext& request_context) {
-  dto::NewCommentRequest comment;
-  comment.slug_ = request.GetPathArg("slug");
-  comment.user_id_ =
-      request_context.GetData<auth::UserAuthData>("user_auth_data").id_;
-  comment.body_ = utils::CheckSize(request_json, "body", 4, 16384);
-  return comment;
-}
-
-}  // namespace
-
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
                    .GetCluster()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value& request_json,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   dto::NewCommentRequest new_comment_request;
   try {
-    new_comment_request =
-        ParseRequest(request, request_json["comment"], request_context);
+    new_comment_request = dto::NewCommentRequest::Parse(request.RequestBody());
   } catch (const errors::ValidationError& ex) {
     request.SetResponseStatus(
         userver::server::http::HttpStatus::kUnprocessableEntity);
-    return ex.ToJson();
+    return ex.GetExternalErrorBody();
   }
-  auto res = cluster_->Execute(
+  new_comment_request.slug_ = request.GetPathArg("slug");
+  new_comment_request.user_id_ = auth::GetUserAuthData(request_context).id_;
+  const auto res = cluster_->Execute(
       userver::storages::postgres::ClusterHostType::kMaster,
       db::sql::kAddNewComment.data(), new_comment_request.slug_,
       new_comment_request.body_, new_comment_request.user_id_);
-
-  const auto comment_id = res.AsSingleRow<std::int32_t>();
-  res = cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                          db::sql::kGetComment.data(), comment_id,
-                          new_comment_request.user_id_);
-
-  userver::formats::json::ValueBuilder builder;
-  builder["comment"] = dto::Comment::Parse(res.AsSingleRow<models::Comment>());
-  return builder.ExtractValue();
+  if (res.IsEmpty()) {
+    request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
+    return std::string{utils::kNullJson};
+  }
+  return dto::ToCommentJson(res.AsSingleRow<models::Comment>());
 }
 
 }  // namespace post
@@ -137,19 +155,18 @@ userver::formats::json::Value Handler::HandleRequestJsonThrow(
     const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
   const auto del_comment_request = ParseRequest(request);
-  const auto user_id =
-      request_context.GetData<auth::UserAuthData>("user_auth_data").id_;
+  const auto user_id = auth::GetUserAuthData(request_context).id_;
   const auto res = cluster_->Execute(
       userver::storages::postgres::ClusterHostType::kMaster,
-      db::sql::kIsCommentExist.data(), del_comment_request.id_,
+      db::sql::kDeleteComment.data(), del_comment_request.id_,
       del_comment_request.slug_, user_id);
-  if (!res.AsSingleRow<bool>()) {
+  if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
     return {};
   }
-  cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                    db::sql::kDeleteComment.data(), del_comment_request.id_,
-                    del_comment_request.slug_, user_id);
+  if (!res.AsSingleRow<bool>()) {
+    throw errors::ForbiddenError{errors::ErrorBuilder{"comment", "forbidden"}};
+  }
   return {};
 }
 
@@ -3,6 +3,7 @@
 #include "common/auth.hpp"
 #include "common/errors.hpp"
 #include "common/utils.hpp"
+#include "components/article_cache.hpp"
 #include "db/sql.hpp"
 #include "db/types.hpp"
 #include "dto/article.hpp"
@@ -17,36 +18,30 @@ namespace realworld::handlers::api::articles_slug_unfavorite::del {
 
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      article_cache_(
+          context.FindComponent<components::ArticleCache>().GetCache()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   const auto& slug = request.GetPathArg("slug");
-  auto res =
+  const auto user_id = auth::GetUserAuthData(request_context).id_;
+  const auto res =
       cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                        db::sql::kGetArticleIdBySlug.data(), slug);
+                        db::sql::kUnfavoriteArticle.data(), slug, user_id);
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-    return {};
+    return std::string{utils::kNullJson};
   }
-  const auto user_id =
-      request_context.GetData<auth::UserAuthData>("user_auth_data").id_;
-  cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                    db::sql::kUnfavoriteArticle.data(), slug, user_id);
-  const auto article_id = res.AsSingleRow<std::int32_t>();
-  res = cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                          db::sql::kGetArticleWithAuthorProfile.data(),
-                          article_id, user_id);
-  userver::formats::json::ValueBuilder builder;
-  builder["article"] =
-      dto::Article::Parse(res.AsSingleRow<models::ArticleWithAuthorProfile>());
-  return builder.ExtractValue();
+  article_cache_.Invalidate(slug);
+  return dto::ToArticleJson(
+      res.AsSingleRow<models::ArticleWithAuthorProfile>());
 }
 
 }  // namespace realworld::handlers::api::articles_slug_unfavorite::del
\ No newline at end of file
@@ -7,7 +7,6 @@
 #include "db/types.hpp"
 #include "dto/profile.hpp"
 #include "models/profile.hpp"
-#include "models/user.hpp"
 #include "userver/formats/json/inline.hpp"
 #include "userver/formats/json/value.hpp"
 #include "userver/formats/yaml/value_builder.hpp"
@@ -24,18 +23,28 @@ Handler::Handler(const userver::components::ComponentConfig& config,
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      users_cache_(context.FindComponent<components::UsersCache>()),
+      follow_graph_(context.FindComponent<components::FollowGraph>()) {}
 
 userver::formats::json::Value Handler::HandleRequestJsonThrow(
     const userver::server::http::HttpRequest& request,
     const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
   const auto& username = request.GetPathArg("username");
-  const auto* user_auth_data =
-      request_context.GetDataOptional<auth::UserAuthData>("user_auth_data");
+  const auto* user_auth_data = auth::GetUserAuthDataOptional(request_context);
   const auto user_id =
       user_auth_data ? std::make_optional<std::int32_t>(user_auth_data->id_)
                      : std::nullopt;
+  userver::formats::json::ValueBuilder builder;
+  if (const auto user = users_cache_.FindByUsername(username)) {
+    const auto following =
+        user_id && follow_graph_.IsFollowing(*user_id, user->id_);
+    builder["profile"] =
+        dto::Profile{user->username_, user->bio_, user->image_, following};
+    return builder.ExtractValue();
+  }
+
   const auto res = cluster_->Execute(
       userver::storages::postgres::ClusterHostType::kSlave,
       db::sql::kGetProfileByUsername.data(), username, user_id);
@@ -44,7 +53,6 @@ userver::formats::json::Value Handler::HandleRequestJsonThrow(
     return {};
   }
   const auto profile = res.AsSingleRow<models::Profile>();
-  userver::formats::json::ValueBuilder builder;
   builder["profile"] = dto::Profile{profile.username_, profile.bio_,
                                     profile.image_, profile.following_};
   return builder.ExtractValue();
@@ -60,29 +68,29 @@ Handler::Handler(const userver::components::ComponentConfig& config,
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      follow_graph_(context.FindComponent<components::FollowGraph>()) {}
 
 userver::formats::json::Value Handler::HandleRequestJsonThrow(
     const userver::server::http::HttpRequest& request,
     const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
   const auto& username = request.GetPathArg("username");
-  const auto res =
-      cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                        db::sql::kGetUserByUsername.data(), username);
+  const auto follower_id = auth::GetUserAuthData(request_context).id_;
+  const auto res = cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      db::sql::kFollow.data(), follower_id, username);
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
     return {};
   }
-  const auto user = res.AsSingleRow<models::User>();
-  cluster_->Execute(
-      userver::storages::postgres::ClusterHostType::kMaster,
-      db::sql::kFollow.data(),
-      request_context.GetData<auth::UserAuthData>("user_auth_data").id_,
-      user.id_);
+  const auto result = res.AsSingleRow<models::FollowResult>(
+      userver::storages::postgres::kRowTag);
+  follow_graph_.OnFollow(follower_id, result);
+  const auto& profile = result.profile_;
   userver::formats::json::ValueBuilder builder;
-  builder["profile"] =
-      dto::Profile{user.username_, user.bio_, user.image_, true};
+  builder["profile"] = dto::Profile{profile.username_, profile.bio_,
+                                    profile.image_, profile.following_};
   return builder.ExtractValue();
 }
 
@@ -96,29 +104,29 @@ Handler::Handler(const userver::components::ComponentConfig& config,
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      follow_graph_(context.FindComponent<components::FollowGraph>()) {}
 
 userver::formats::json::Value Handler::HandleRequestJsonThrow(
     const userver::server::http::HttpRequest& request,
     const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
   const auto& username = request.GetPathArg("username");
-  const auto res =
-      cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
-                        db::sql::kGetUserByUsername.data(), username);
+  const auto follower_id = auth::GetUserAuthData(request_context).id_;
+  const auto res = cluster_->Execute(
+      userver::storages::postgres::ClusterHostType::kMaster,
+      db::sql::kUnfollow.data(), follower_id, username);
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
     return {};
   }
-  const auto user = res.AsSingleRow<models::User>();
-  cluster_->Execute(
-      userver::storages::postgres::ClusterHostType::kMaster,
-      db::sql::kUnfollow.data(),
-      request_context.GetData<auth::UserAuthData>("user_auth_data").id_,
-      user.id_);
+  const auto result = res.AsSingleRow<models::FollowResult>(
+      userver::storages::postgres::kRowTag);
+  follow_graph_.OnUnfollow(follower_id, result);
+  const auto& profile = result.profile_;
   userver::formats::json::ValueBuilder builder;
-  builder["profile"] =
-      dto::Profile{user.username_, user.bio_, user.image_, false};
+  builder["profile"] = dto::Profile{profile.username_, profile.bio_,
+                                    profile.image_, profile.following_};
   return builder.ExtractValue();
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string_view>
+#include "components/follow_graph.hpp"
+#include "components/users_cache.hpp"
 #include "userver/components/component_config.hpp"
 #include "userver/components/component_context.hpp"
 #include "userver/formats/json/value.hpp"
@@ -27,6 +29,8 @@ class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
+  const components::UsersCache& users_cache_;
+  const components::FollowGraph& follow_graph_;
 };
 
 }  // namespace get
@@ -48,6 +52,7 @@ class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
+  const components::FollowGraph& follow_graph_;
 };
 
 }  // namespace post
@@ -69,6 +74,7 @@ class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
+  const components::FollowGraph& follow_graph_;
 };
 
 }  // namespace del
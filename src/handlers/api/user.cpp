@@ -1,8 +1,8 @@
 #include "user.hpp"
-#include "bcrypt/BCrypt.hpp"
 #include "common/auth.hpp"
 #include "common/errors.hpp"
 #include "common/utils.hpp"
+#include "components/password_hasher.hpp"
 #include "db/sql.hpp"
 #include "db/types.hpp"
 #include "dto/profile.hpp"
@@ -21,96 +21,65 @@ namespace get {
 
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      users_cache_(context.FindComponent<components::UsersCache>()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value&,
     userver::server::request::RequestContext& request_context) const {
-  const auto& user_auth_data =
-      request_context.GetData<auth::UserAuthData>("user_auth_data");
+  utils::SetJsonContentType(request);
+  const auto& user_auth_data = auth::GetUserAuthData(request_context);
+  if (const auto user = users_cache_.FindById(user_auth_data.id_)) {
+    return dto::ToUserJson({user->email_, std::string{user_auth_data.token_},
+                            user->username_, user->bio_, user->image_});
+  }
   const auto res =
       cluster_->Execute(userver::storages::postgres::ClusterHostType::kSlave,
                         db::sql::kGetUserById.data(), user_auth_data.id_);
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-    return {};
+    return std::string{utils::kNullJson};
   }
   const auto user = res.AsSingleRow<models::User>();
-  userver::formats::json::ValueBuilder builder;
-  builder["user"] = dto::User{user.email_, user_auth_data.token_.get_token(),
-                              user.username_, user.bio_, user.image_};
-  return builder.ExtractValue();
+  return dto::ToUserJson({user.email_, std::string{user_auth_data.token_},
+                          user.username_, user.bio_, user.image_});
 }
 
 }  // namespace get
 
 namespace put {
 
-namespace {
-
-dto::UpdateUserRequest ParseRequest(const userver::formats::json::Value& data) {
-  dto::UpdateUserRequest update_req;
-  if (update_req.email_ = data["email"].As<std::optional<std::string>>();
-      update_req.email_) {
-    utils::ValidateEmail(data, "email");
-  }
-  if (update_req.username_ = data["username"].As<std::optional<std::string>>();
-      update_req.username_) {
-    utils::CheckSize(*update_req.username_, "username", 2, 20);
-  }
-  if (update_req.password_ = data["password"].As<std::optional<std::string>>();
-      update_req.password_) {
-    utils::CheckSize(*update_req.password_, "password", 5, 100);
-  }
-  if (update_req.bio_ = data["bio"].As<std::optional<std::string>>();
-      update_req.bio_) {
-    utils::CheckSize(*update_req.bio_, "bio", 3, 65535);
-  }
-  if (update_req.image_ = data["image"].As<std::optional<std::string>>();
-      update_req.image_) {
-    utils::CheckSize(*update_req.image_, "image", 3, 255);
-  }
-  if (!update_req.email_ && !update_req.username_ && !update_req.password_ &&
-      !update_req.bio_ && !update_req.image_) {
-    throw errors::ValidationError{
-        errors::ErrorBuilder{"user", "cannot be empty"}};
-  }
-  return update_req;
-}
-
-}  // namespace
-
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
-                   .GetCluster()) {}
+                   .GetCluster()),
+      password_hasher_(context.FindComponent<components::PasswordHasher>()),
+      users_cache_(context.FindComponent<components::UsersCache>()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value& request_json,
     userver::server::request::RequestContext& request_context) const {
+  utils::SetJsonContentType(request);
   dto::UpdateUserRequest update_user_request;
   try {
-    update_user_request = ParseRequest(request_json["user"]);
+    update_user_request = dto::UpdateUserRequest::Parse(request.RequestBody());
   } catch (const errors::ValidationError& ex) {
     request.SetResponseStatus(
         userver::server::http::HttpStatus::kUnprocessableEntity);
-    return ex.ToJson();
+    return ex.GetExternalErrorBody();
   }
-  const auto& user_auth_data =
-      request_context.GetData<auth::UserAuthData>("user_auth_data");
+  const auto& user_auth_data = auth::GetUserAuthData(request_context);
   const auto password_hash =
       update_user_request.password_
           ? std::make_optional<std::string>(
-                BCrypt::generateHash(*update_user_request.password_))
+                password_hasher_.GenerateHash(*update_user_request.password_))
           : std::nullopt;
 
   const auto res = cluster_->Execute(
@@ -120,14 +89,13 @@ userver::formats::json::Value Handler::HandleRequestJsonThrow(
       update_user_request.bio_, update_user_request.image_);
   if (res.IsEmpty()) {
     request.SetResponseStatus(userver::server::http::HttpStatus::kNotFound);
-    return {};
+    return std::string{utils::kNullJson};
   }
 
   const auto user = res.AsSingleRow<models::User>();
-  userver::formats::json::ValueBuilder builder;
-  builder["user"] = dto::User{user.email_, user_auth_data.token_.get_token(),
-                              user.username_, user.bio_, user.image_};
-  return builder.ExtractValue();
+  users_cache_.OnUpdate(user);
+  return dto::ToUserJson({user.email_, std::string{user_auth_data.token_},
+                          user.username_, user.bio_, user.image_});
 }
 
 }  // namespace put
@@ -1,10 +1,10 @@
 #include "users.hpp"
 #include <userver/storages/secdist/component.hpp>
-#include "bcrypt/BCrypt.hpp"
 #include "common/auth.hpp"
 #include "common/errors.hpp"
 #include "common/jwt.hpp"
 #include "common/utils.hpp"
+#include "components/password_hasher.hpp"
 #include "db/sql.hpp"
 #include "db/types.hpp"
 #include "dto/auth.hpp"
@@ -17,46 +17,35 @@
 
 namespace realworld::handlers::api::users::post {
 
-namespace {
-
-dto::RegistrationRequest ParseRequest(
-    const userver::formats::json::Value& data) {
-  dto::RegistrationRequest reg_request;
-  reg_request.username_ = utils::CheckSize(data, "username", 2, 20);
-  reg_request.password_ = utils::CheckSize(data, "password", 5, 100);
-  reg_request.email_ = utils::ValidateEmail(data, "email");
-  return reg_request;
-}
-
-}  // namespace
-
 Handler::Handler(const userver::components::ComponentConfig& config,
                  const userver::components::ComponentContext& context)
-    : HttpHandlerJsonBase(config, context),
+    : JsonResponseHandlerBase(config, context),
       cluster_(context
                    .FindComponent<userver::components::Postgres>(
                        "realworld-database")
                    .GetCluster()),
       jwt_manager_(context.FindComponent<userver::components::Secdist>()
                        .Get()
-                       .Get<jwt::JWTConfig>()) {}
+                       .Get<jwt::JWTConfig>()),
+      password_hasher_(context.FindComponent<components::PasswordHasher>()) {}
 
-userver::formats::json::Value Handler::HandleRequestJsonThrow(
+std::string Handler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value& request_json,
     userver::server::request::RequestContext&) const {
+  utils::SetJsonContentType(request);
   dto::RegistrationRequest reg_request;
   try {
-    reg_request = ParseRequest(request_json["user"]);
+    reg_request = dto::RegistrationRequest::Parse(request.RequestBody());
   } catch (const errors::ValidationError& ex) {
     request.SetResponseStatus(
         userver::server::http::HttpStatus::kUnprocessableEntity);
-    return ex.ToJson();
+    return ex.GetExternalErrorBody();
   }
 
   std::int32_t user_id{};
   try {
-    const auto password_hash = BCrypt::generateHash(reg_request.password_);
+    const auto password_hash =
+        password_hasher_.GenerateHash(reg_request.password_);
     const auto res =
         cluster_->Execute(userver::storages::postgres::ClusterHostType::kMaster,
                           db::sql::kAddNewUser.data(), reg_request.username_,
@@ -73,16 +62,15 @@ userver::formats::json::Value Handler::HandleRequestJsonThrow(
     if (name) {
       request.SetResponseStatus(
           userver::server::http::HttpStatus::kUnprocessableEntity);
-      return errors::MakeError(*name, "has already been taken");
+      return errors::ErrorBuilder{*name, "has already been taken"}
+          .GetExternalBody();
     }
     throw;
   }
 
-  userver::formats::json::ValueBuilder builder;
-  builder["user"] =
-      dto::User{reg_request.email_, jwt_manager_.GenerateToken(user_id),
-                reg_request.username_};
-  return builder.ExtractValue();
+  return dto::ToUserJson({reg_request.email_,
+                          jwt_manager_.GenerateToken(user_id),
+                          reg_request.username_});
 }
 
 }  // namespace realworld::handlers::api::users::post
\ No newline at end of file
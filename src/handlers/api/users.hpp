@@ -1,31 +1,33 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 #include "common/jwt.hpp"
+#include "components/password_hasher.hpp"
+#include "handlers/json_response_handler_base.hpp"
 #include "userver/components/component_config.hpp"
 #include "userver/components/component_context.hpp"
 #include "userver/formats/json/value.hpp"
-#include "userver/server/handlers/http_handler_base.hpp"
 #include "userver/server/handlers/http_handler_json_base.hpp"
 #include "userver/storages/postgres/postgres_fwd.hpp"
 
 namespace realworld::handlers::api::users::post {
 
-class Handler final : public userver::server::handlers::HttpHandlerJsonBase {
+class Handler final : public JsonResponseHandlerBase {
  public:
   static constexpr std::string_view kName{"handler-post-api-users"};
 
   Handler(const userver::components::ComponentConfig& config,
           const userver::components::ComponentContext& context);
 
-  userver::formats::json::Value HandleRequestJsonThrow(
+  std::string HandleRequestThrow(
       const userver::server::http::HttpRequest& request,
-      const userver::formats::json::Value& request_json,
       userver::server::request::RequestContext& context) const override final;
 
  private:
   const userver::storages::postgres::ClusterPtr cluster_;
   const jwt::JWTManager jwt_manager_;
+  const components::PasswordHasher& password_hasher_;
 };
 
 }  // namespace realworld::handlers::api::users::post
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <memory>
 #include <userver/storages/secdist/component.hpp>
 #include "common/auth.hpp"
+#include "components/token_cache.hpp"
 
 namespace realworld::handlers::auth {
 
@@ -31,12 +32,10 @@ AuthChecker::AuthCheckResult AuthChecker::CheckAuth(
         userver::server::handlers::HandlerErrorCode::kUnauthorized};
   }
 
-  const std::string token{auth_value.data() + token_pos + 1};
-  std::optional<jwt::DecodedToken> decoded_token;
-  try {
-    decoded_token = ::jwt::decode(token);
-    jwt_manager_.VerifyToken(*decoded_token);
-  } catch (const std::exception&) {
+  const std::string_view token{auth_value.data() + token_pos + 1,
+                               auth_value.size() - token_pos - 1};
+  const auto id = GetUserId(token);
+  if (!id) {
     return AuthCheckResult{
         AuthCheckResult::Status::kInvalidToken,
         {},
@@ -44,13 +43,33 @@ AuthChecker::AuthCheckResult AuthChecker::CheckAuth(
         userver::server::handlers::HandlerErrorCode::kUnauthorized};
   }
 
-  const auto id = static_cast<std::int32_t>(
-      (*decoded_token).get_payload_claim("id").as_integer());
-  const realworld::auth::UserAuthData user_auth_data{id, *decoded_token};
-  request_context.SetData("user_auth_data", user_auth_data);
+  realworld::auth::SetUserAuthData(request_context, {*id, token});
   return {};
 }
 
+std::optional<std::int32_t> AuthChecker::GetUserId(
+    std::string_view token) const {
+  if (token_cache_) {
+    if (const auto id = token_cache_->Get(token)) {
+      return id;
+    }
+  }
+
+  jwt::TokenPayload payload;
+  try {
+    payload = jwt_manager_.VerifyToken(token);
+  } catch (const jwt::TokenVerificationError&) {
+    return std::nullopt;
+  }
+
+  const auto id = static_cast<std::int32_t>(payload.id_);
+  // Tokens without expiration are never cached
+  if (token_cache_ && payload.expires_at_) {
+    token_cache_->Put(token, id, *payload.expires_at_);
+  }
+  return id;
+}
+
 userver::server::handlers::auth::AuthCheckerBasePtr CheckerFactory::operator()(
     const userver::components::ComponentContext& context,
     const userver::server::handlers::auth::HandlerAuthConfig& config,
@@ -60,8 +79,10 @@ userver::server::handlers::auth::AuthCheckerBasePtr CheckerFactory::operator()(
                               .Get<jwt::JWTConfig>();
   const auto is_optional_auth =
       config.HasMember("optional") ? config["optional"].As<bool>() : false;
-  const auto res =
-      std::make_shared<AuthChecker>(std::move(jwt_config), is_optional_auth);
+  const auto& token_cache =
+      context.FindComponent<components::TokenCache>().GetCache();
+  const auto res = std::make_shared<AuthChecker>(
+      std::move(jwt_config), is_optional_auth, &token_cache);
   return res;
 }
 
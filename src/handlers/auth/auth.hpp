@@ -2,6 +2,7 @@
 
 #include <userver/server/handlers/auth/auth_checker_factory.hpp>
 #include "common/jwt.hpp"
+#include "common/token_cache.hpp"
 
 namespace realworld::handlers::auth {
 
@@ -10,8 +11,11 @@ class AuthChecker final
  public:
   using AuthCheckResult = userver::server::handlers::auth::AuthCheckResult;
 
-  AuthChecker(const jwt::JWTConfig& config, bool is_optional_auth = false)
-      : jwt_manager_{config}, is_optional_auth_{is_optional_auth} {}
+  AuthChecker(const jwt::JWTConfig& config, bool is_optional_auth = false,
+              const realworld::auth::TokenCache* token_cache = nullptr)
+      : jwt_manager_{config},
+        is_optional_auth_{is_optional_auth},
+        token_cache_{token_cache} {}
 
   [[nodiscard]] AuthCheckResult CheckAuth(
       const userver::server::http::HttpRequest& request,
@@ -19,9 +23,14 @@ class AuthChecker final
 
   [[nodiscard]] bool SupportsUserAuth() const noexcept override { return true; }
 
+  // Returns the id of the user the token was issued to or std::nullopt if
+  // the token is malformed, forged or expired.
+  std::optional<std::int32_t> GetUserId(std::string_view token) const;
+
  private:
   const jwt::JWTManager jwt_manager_;
   const bool is_optional_auth_;
+  const realworld::auth::TokenCache* const token_cache_;
 };
 
 class CheckerFactory final
@@ -34,4 +43,4 @@ class CheckerFactory final
       const override;
 };
 
-}  // namespace realworld::handlers::auth
\ No newline at end of file
+}  // namespace realworld::handlers::auth
@@ -0,0 +1,43 @@
+#include "auth.hpp"
+#include <benchmark/benchmark.h>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/formats/json/serialize_duration.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+namespace realworld {
+
+namespace {
+
+jwt::JWTConfig GetTestConfig() {
+  userver::formats::json::ValueBuilder builder;
+  builder["secret_key"] = "secret_key";
+  builder["jwt_expiration_time"] = std::chrono::seconds{86400};
+  return jwt::JWTConfig{builder.ExtractValue()};
+}
+
+void RunGetUserId(benchmark::State& state, bool use_cache) {
+  userver::engine::RunStandalone([&] {
+    const auto config = GetTestConfig();
+    const realworld::auth::TokenCache token_cache{16, 4096};
+    const handlers::auth::AuthChecker checker{
+        config, false, use_cache ? &token_cache : nullptr};
+    const auto token = jwt::JWTManager{config}.GenerateToken(666);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(checker.GetUserId(token));
+    }
+  });
+}
+
+}  // namespace
+
+void AuthCheckerWithoutCache(benchmark::State& state) {
+  RunGetUserId(state, false);
+}
+BENCHMARK(AuthCheckerWithoutCache);
+
+void AuthCheckerWithCache(benchmark::State& state) {
+  RunGetUserId(state, true);
+}
+BENCHMARK(AuthCheckerWithCache);
+
+}  // namespace realworld
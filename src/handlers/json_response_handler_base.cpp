@@ -0,0 +1,14 @@
+#include "json_response_handler_base.hpp"
+#include "userver/http/content_type.hpp"
+#include "userver/server/handlers/json_error_builder.hpp"
+
+namespace realworld::handlers {
+
+userver::server::handlers::FormattedErrorData
+JsonResponseHandlerBase::GetFormattedExternalErrorBody(
+    const userver::server::handlers::CustomHandlerException& exc) const {
+  return {userver::server::handlers::JsonErrorBuilder{exc}.GetExternalBody(),
+          userver::http::content_type::kApplicationJson};
+}
+
+}  // namespace realworld::handlers
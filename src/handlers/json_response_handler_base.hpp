@@ -0,0 +1,21 @@
+#pragma once
+
+#include "userver/server/handlers/http_handler_base.hpp"
+
+namespace realworld::handlers {
+
+// Base of the handlers that write their JSON response body themselves.
+// Errors raised outside of them, such as the 401 of the auth checker, keep
+// the {"code", "message"} JSON body HttpHandlerJsonBase sends.
+class JsonResponseHandlerBase
+    : public userver::server::handlers::HttpHandlerBase {
+ public:
+  using HttpHandlerBase::HttpHandlerBase;
+
+ protected:
+  userver::server::handlers::FormattedErrorData GetFormattedExternalErrorBody(
+      const userver::server::handlers::CustomHandlerException& exc)
+      const override;
+};
+
+}  // namespace realworld::handlers
@@ -7,6 +7,14 @@
 #include <userver/storages/secdist/provider_component.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
 #include <userver/utils/daemon_run.hpp>
+#include "components/allocation_statistics.hpp"
+#include "components/article_cache.hpp"
+#include "components/follow_graph.hpp"
+#include "components/password_hasher.hpp"
+#include "components/statements_warmup.hpp"
+#include "components/tags_cache.hpp"
+#include "components/token_cache.hpp"
+#include "components/users_cache.hpp"
 #include "handlers/api/articles.hpp"
 #include "handlers/api/articles_feed.hpp"
 #include "handlers/api/articles_slug.hpp"
@@ -36,6 +44,15 @@ int main(int argc, char* argv[]) {
           .Append<userver::components::Secdist>()
           .Append<userver::components::DefaultSecdistProvider>()
           .Append<userver::clients::dns::Component>()
+          .Append<components::AllocationStatistics>()
+          .Append<components::ArticleCache>()
+          .Append<components::FollowGraph>()
+          .Append<components::PasswordHasher>()
+          .Append<components::StatementsWarmup>()
+          .Append<components::TagsCache>()
+          .Append<components::TokenCache>()
+          .Append<components::UsersSnapshot>()
+          .Append<components::UsersCache>()
           .Append<handlers::api::articles::get::Handler>()
           .Append<handlers::api::articles::post::Handler>()
           .Append<handlers::api::articles_feed::get::Handler>()
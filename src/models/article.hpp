@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <db/text_view.hpp>
 #include <db/types.hpp>
 #include <models/user.hpp>
 #include <optional>
@@ -26,6 +27,37 @@ struct ArticleWithAuthorProfile final {
   Profile author_;
 };
 
+// A row of the list and feed statements read with kRowTag: the columns of
+// article_with_author_profile and the author id, for the follow graph.
+// author_.following_ is left false by those statements. Text is not copied
+// out of the result set, so a row must not outlive it.
+struct ArticleWithAuthorProfileView final {
+  int article_id_;
+  db::TextView title_;
+  db::TextView slug_;
+  db::TextView description_;
+  db::TextView body_;
+  std::chrono::system_clock::time_point created_at_;
+  std::chrono::system_clock::time_point updated_at_;
+  std::optional<std::vector<db::TextView>> tag_list_;
+  bool favorited_;
+  std::int64_t favorites_count_;
+  Profile author_;
+  std::int32_t author_id_;
+};
+
+// The columns of an article that depend on who reads it
+struct ArticleViewerFlags final {
+  bool favorited_;
+  bool following_;
+};
+
+// A row of update_article_by_slug: no article when it is not the author's
+struct UpdatedArticle final {
+  bool owned_;
+  std::optional<ArticleWithAuthorProfile> article_;
+};
+
 }  // namespace realworld::models
 
 namespace userver::storages::postgres::io {
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <userver/storages/postgres/io/io_fwd.hpp>
 #include <userver/storages/postgres/io/pg_types.hpp>
+#include "db/text_view.hpp"
 #include "db/types.hpp"
 #include "models/profile.hpp"
 
@@ -16,6 +19,18 @@ struct Comment final {
   Profile author_;
 };
 
+// A row of get_comments_from_article read with kRowTag: the same columns and
+// the author id, the body points into the result set. author_.following_ is
+// left false by that statement.
+struct CommentView final {
+  int comment_id;
+  std::chrono::system_clock::time_point created_at;
+  std::chrono::system_clock::time_point updated_at_;
+  db::TextView body_;
+  Profile author_;
+  std::int32_t author_id_;
+};
+
 }  // namespace realworld::models
 
 namespace userver::storages::postgres::io {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <userver/storages/postgres/io/io_fwd.hpp>
@@ -16,6 +18,14 @@ struct Profile final {
   bool following_{false};
 };
 
+// A row of follow and unfollow: the followed user, when the edge changed in
+// realworld.follow_changes, and the profile
+struct FollowResult final {
+  std::int32_t user_id_;
+  std::chrono::system_clock::time_point changed_at_;
+  Profile profile_;
+};
+
 }  // namespace realworld::models
 
 namespace userver::storages::postgres::io {
@@ -17,6 +17,15 @@ struct User final {
   std::optional<std::string> image_;
 };
 
+// A user without the password hash, the row the users cache keeps
+struct UserRecord final {
+  std::int32_t id_;
+  std::string username_;
+  std::string email_;
+  std::optional<std::string> bio_;
+  std::optional<std::string> image_;
+};
+
 }  // namespace realworld::models
 
 namespace userver::storages::postgres::io {
@@ -22,3 +22,61 @@ def pgsql_local(service_source_dir, pgsql_local_create):
         [service_source_dir.joinpath('postgresql/schemas')],
     )
     return pgsql_local_create(list(databases.values()))
+
+
+@pytest.fixture
+def register(service_client):
+    """Registers a user, returns the headers to act as them"""
+    async def _register(name):
+        response = await service_client.post(
+            '/api/users',
+            json={'user': {
+                'username': name,
+                'email': name + '@example.com',
+                'password': 'password'
+            }
+            },
+        )
+        assert response.status == 200
+        return {'Authorization': 'Token ' + response.json()['user']['token']}
+    return _register
+
+
+@pytest.fixture
+def post_article(service_client):
+    """Posts an article, returns its slug"""
+    async def _post_article(author, title, tags=None):
+        article = {
+            'title': title,
+            'description': 'description',
+            'body': 'body',
+        }
+        if tags is not None:
+            article['tagList'] = tags
+        response = await service_client.post(
+            '/api/articles', json={'article': article}, headers=author)
+        assert response.status == 200
+        return response.json()['article']['slug']
+    return _post_article
+
+
+@pytest.fixture
+def get_article(service_client):
+    """Reads an article that must exist"""
+    async def _get_article(slug, headers=None):
+        response = await service_client.get(
+            '/api/articles/' + slug, headers=headers)
+        assert response.status == 200
+        return response.json()['article']
+    return _get_article
+
+
+@pytest.fixture
+def get_profile(service_client):
+    """Reads a profile that must exist"""
+    async def _get_profile(username, headers=None):
+        response = await service_client.get(
+            '/api/profiles/' + username, headers=headers)
+        assert response.status == 200
+        return response.json()['profile']
+    return _get_profile
@@ -0,0 +1,76 @@
+async def test_viewer_flags_of_cached_article(
+        service_client, register, post_article, get_article):
+    author = await register("author")
+    reader = await register("reader")
+    slug = await post_article(author, "Cached")
+    response = await service_client.post(
+        "/api/articles/" + slug + "/favorite", headers=reader)
+    assert response.status == 200
+    response = await service_client.post(
+        "/api/profiles/author/follow", headers=reader)
+    assert response.status == 200
+
+    # The first read caches the article for everybody
+    article = await get_article(slug, reader)
+    assert article["favorited"]
+    assert article["author"]["following"]
+    for headers in [None, author]:
+        article = await get_article(slug, headers)
+        assert not article["favorited"]
+        assert not article["author"]["following"]
+        assert article["favoritesCount"] == 1
+    article = await get_article(slug, reader)
+    assert article["favorited"]
+    assert article["author"]["following"]
+
+    response = await service_client.delete(
+        "/api/profiles/author/follow", headers=reader)
+    assert response.status == 200
+    article = await get_article(slug, reader)
+    assert not article["author"]["following"]
+
+
+async def test_writes_invalidate(
+        service_client, register, post_article, get_article):
+    author = await register("author")
+    reader = await register("reader")
+    slug = await post_article(author, "Cached")
+    await get_article(slug)
+
+    response = await service_client.post(
+        "/api/articles/" + slug + "/favorite", headers=reader)
+    assert response.status == 200
+    assert (await get_article(slug))["favoritesCount"] == 1
+    response = await service_client.delete(
+        "/api/articles/" + slug + "/favorite", headers=reader)
+    assert response.status == 200
+    assert (await get_article(slug))["favoritesCount"] == 0
+
+    response = await service_client.put(
+        "/api/articles/" + slug,
+        json={"article": {"body": "new body"}},
+        headers=author,
+    )
+    assert response.status == 200
+    assert (await get_article(slug))["body"] == "new body"
+
+    response = await service_client.put(
+        "/api/articles/" + slug,
+        json={"article": {"title": "Renamed"}},
+        headers=author,
+    )
+    assert response.status == 200
+    new_slug = response.json()["article"]["slug"]
+    assert new_slug != slug
+    response = await service_client.get("/api/articles/" + slug)
+    assert response.status == 404
+    assert (await get_article(new_slug))["title"] == "Renamed"
+
+    response = await service_client.delete(
+        "/api/articles/" + new_slug, headers=author)
+    assert response.status == 200
+    response = await service_client.get("/api/articles/" + new_slug)
+    assert response.status == 404
+    response = await service_client.get(
+        "/api/articles/" + new_slug, headers=reader)
+    assert response.status == 404
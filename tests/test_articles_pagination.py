@@ -0,0 +1,80 @@
+import pytest
+
+
+ARTICLES_COUNT = 5
+
+
+async def test_cursor_pages(service_client, register, post_article):
+    author = await register("author")
+    for i in range(ARTICLES_COUNT):
+        await post_article(author, "Article " + str(i))
+
+    response = await service_client.get("/api/articles")
+    assert response.status == 200
+    expected = [article["slug"] for article in response.json()["articles"]]
+    assert len(expected) == ARTICLES_COUNT
+
+    slugs = []
+    params = {"limit": "2"}
+    while True:
+        response = await service_client.get("/api/articles", params=params)
+        assert response.status == 200
+        slugs += [article["slug"] for article in response.json()["articles"]]
+        cursor = response.json()["nextCursor"]
+        if cursor is None:
+            break
+        params["cursor"] = cursor
+    assert slugs == expected
+
+    # The limit/offset pages stay the same
+    response = await service_client.get(
+        "/api/articles", params={"limit": "2", "offset": "2"})
+    assert response.status == 200
+    assert [article["slug"] for article in response.json()["articles"]] == \
+        expected[2:4]
+
+
+async def test_comment_pages(service_client, register, post_article):
+    author = await register("author")
+    slug = await post_article(author, "Discussed")
+    url = "/api/articles/" + slug + "/comments"
+    bodies = ["Comment " + str(i) for i in range(ARTICLES_COUNT)]
+    for body in bodies:
+        response = await service_client.post(
+            url, json={"comment": {"body": body}}, headers=author)
+        assert response.status == 200
+
+    # Without limit or cursor all comments come at once, oldest first
+    response = await service_client.get(url)
+    assert response.status == 200
+    assert [c["body"] for c in response.json()["comments"]] == bodies
+    assert "nextCursor" not in response.json()
+
+    pages = []
+    params = {"limit": "2"}
+    while True:
+        response = await service_client.get(url, params=params)
+        assert response.status == 200
+        pages += [c["body"] for c in response.json()["comments"]]
+        cursor = response.json()["nextCursor"]
+        if cursor is None:
+            break
+        params["cursor"] = cursor
+    assert pages == bodies
+
+
+@pytest.mark.parametrize(
+    'params',
+    [
+        {"limit": "abc"},
+        {"limit": "0"},
+        {"limit": "101"},
+        {"limit": "99999999999"},
+        {"offset": "-1"},
+        {"offset": "1.5"},
+        {"cursor": "not a cursor"},
+    ],
+)
+async def test_invalid_page_args(service_client, params):
+    response = await service_client.get("/api/articles", params=params)
+    assert response.status == 400
@@ -0,0 +1,65 @@
+import asyncio
+
+
+USERS_COUNT = 40
+
+
+def get_counter_mismatches(pgsql):
+    cursor = pgsql["db_1"].cursor()
+    cursor.execute(
+        "SELECT * FROM realworld.get_favorites_counter_mismatches()")
+    return cursor.fetchall()
+
+
+async def test_concurrent_favorites(
+        service_client, pgsql, register, get_article):
+    author = await register("author")
+    response = await service_client.post(
+        "/api/articles",
+        json={"article": {
+            "title": "Hot article",
+            "description": "Everybody likes it",
+            "body": "body"
+        }
+        },
+        headers=author,
+    )
+    assert response.status == 200
+    slug = response.json()["article"]["slug"]
+    url = "/api/articles/" + slug + "/favorite"
+
+    users = await asyncio.gather(*[
+        register("reader" + str(i))
+        for i in range(USERS_COUNT)
+    ])
+
+    responses = await asyncio.gather(*[
+        service_client.post(url, headers=user) for user in users
+    ])
+    assert all(response.status == 200 for response in responses)
+    assert (await get_article(slug))["favoritesCount"] == USERS_COUNT
+
+    # Favoriting again must not be counted twice
+    responses = await asyncio.gather(*[
+        service_client.post(url, headers=user) for user in users[:5]
+    ])
+    assert all(response.status == 200 for response in responses)
+    assert (await get_article(slug))["favoritesCount"] == USERS_COUNT
+
+    responses = await asyncio.gather(*[
+        service_client.delete(url, headers=user)
+        for user in users[::2] + users[::2]
+    ])
+    assert all(response.status == 200 for response in responses)
+    assert (await get_article(slug))["favoritesCount"] == USERS_COUNT // 2
+
+    assert get_counter_mismatches(pgsql) == []
+
+
+async def test_unauthenticated(service_client):
+    for method in [service_client.post, service_client.delete]:
+        response = await method("/api/articles/some-slug/favorite")
+        assert response.status == 401
+        assert response.headers["Content-Type"].startswith(
+            "application/json")
+        assert response.json()["message"] == "Missing authorization token"
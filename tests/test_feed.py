@@ -0,0 +1,76 @@
+async def get_feed(service_client, user):
+    response = await service_client.get("/api/articles/feed", headers=user)
+    assert response.status == 200
+    return [article["slug"] for article in response.json()["articles"]]
+
+
+async def follow(service_client, user, username):
+    response = await service_client.post(
+        "/api/profiles/" + username + "/follow", headers=user)
+    assert response.status == 200
+
+
+async def unfollow(service_client, user, username):
+    response = await service_client.delete(
+        "/api/profiles/" + username + "/follow", headers=user)
+    assert response.status == 200
+
+
+async def test_timeline(service_client, register, post_article):
+    alice = await register("alice")
+    bob = await register("bob")
+    reader = await register("reader")
+
+    # Articles written before the follow are copied into the timeline
+    old = await post_article(alice, "Old article")
+    await follow(service_client, reader, "alice")
+    await follow(service_client, reader, "bob")
+    assert await get_feed(service_client, reader) == [old]
+
+    # New articles are fanned out to the followers
+    first = await post_article(bob, "First article")
+    second = await post_article(alice, "Second article")
+    assert await get_feed(service_client, reader) == [second, first, old]
+
+    response = await service_client.delete(
+        "/api/articles/" + first, headers=bob)
+    assert response.status == 200
+    assert await get_feed(service_client, reader) == [second, old]
+
+    await unfollow(service_client, reader, "alice")
+    assert await get_feed(service_client, reader) == []
+
+
+async def test_pull_author(service_client, pgsql, register, post_article):
+    cursor = pgsql["db_1"].cursor()
+    cursor.execute(
+        "CREATE OR REPLACE FUNCTION realworld.timeline_max_fanout() "
+        "RETURNS INT AS $$ SELECT 1; $$ LANGUAGE sql IMMUTABLE")
+    try:
+        star = await register("star")
+        fans = [await register("fan" + str(i))
+                for i in range(2)]
+        for fan in fans:
+            await follow(service_client, fan, "star")
+
+        # With more followers than the limit the article is not fanned out
+        # but merged into the feeds at read time
+        slug = await post_article(star, "Star article")
+        cursor.execute(
+            "SELECT COUNT(*) FROM realworld.timelines AS t "
+            "INNER JOIN realworld.users AS u ON u.user_id = t.author_id "
+            "WHERE u.username = 'star'")
+        assert cursor.fetchone()[0] == 0
+        for fan in fans:
+            assert await get_feed(service_client, fan) == [slug]
+    finally:
+        cursor.execute(
+            "CREATE OR REPLACE FUNCTION realworld.timeline_max_fanout() "
+            "RETURNS INT AS $$ SELECT 10000; $$ LANGUAGE sql IMMUTABLE")
+
+
+async def test_unauthenticated(service_client):
+    response = await service_client.get("/api/articles/feed")
+    assert response.status == 401
+    assert response.headers["Content-Type"].startswith("application/json")
+    assert response.json()["message"] == "Missing authorization token"
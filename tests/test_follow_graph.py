@@ -0,0 +1,98 @@
+async def follow(service_client, headers, username, following=True):
+    url = "/api/profiles/" + username + "/follow"
+    if following:
+        response = await service_client.post(url, headers=headers)
+    else:
+        response = await service_client.delete(url, headers=headers)
+    assert response.status == 200
+    assert response.json()["profile"]["following"] == following
+
+
+async def get_list_following(service_client, headers, slug):
+    response = await service_client.get("/api/articles", headers=headers)
+    assert response.status == 200
+    list_following = [article["author"]["following"]
+                      for article in response.json()["articles"]]
+    response = await service_client.get(
+        "/api/articles/" + slug + "/comments", headers=headers)
+    assert response.status == 200
+    comments_following = [comment["author"]["following"]
+                          for comment in response.json()["comments"]]
+    return list_following, comments_following
+
+
+async def test_follows_are_applied_to_graph(
+        service_client, register, post_article, get_profile):
+    jake = await register("jake")
+    reader = await register("reader")
+    slug = await post_article(jake, "Dragons")
+    response = await service_client.post(
+        "/api/articles/" + slug + "/comments",
+        json={"comment": {"body": "Mine"}}, headers=jake)
+    assert response.status == 200
+    # Profiles of cached users are answered by the graph
+    await service_client.invalidate_caches()
+
+    assert not (await get_profile("jake", reader))["following"]
+    assert await get_list_following(service_client, reader, slug) == (
+        [False], [False])
+
+    # Before any update of the graph
+    await follow(service_client, reader, "jake")
+    assert (await get_profile("Jake", reader))["following"]
+    assert await get_list_following(service_client, reader, slug) == (
+        [True], [True])
+    # Nobody is following for an anonymous reader
+    assert await get_list_following(service_client, None, slug) == (
+        [False], [False])
+
+    await service_client.invalidate_caches(clean_update=False)
+    assert (await get_profile("jake", reader))["following"]
+    await service_client.invalidate_caches()
+    assert (await get_profile("jake", reader))["following"]
+
+    await follow(service_client, reader, "jake", following=False)
+    assert not (await get_profile("jake", reader))["following"]
+    assert await get_list_following(service_client, reader, slug) == (
+        [False], [False])
+    await service_client.invalidate_caches(clean_update=False)
+    assert not (await get_profile("jake", reader))["following"]
+    await service_client.invalidate_caches()
+    assert not (await get_profile("jake", reader))["following"]
+
+
+async def test_follows_of_other_instances(
+        service_client, pgsql, register, get_profile):
+    await register("jake")
+    reader = await register("reader")
+    await service_client.invalidate_caches()
+    cursor = pgsql["db_1"].cursor()
+    cursor.execute(
+        "SELECT user_id FROM realworld.users WHERE username = 'reader'")
+    reader_id = cursor.fetchone()[0]
+
+    # Written by another instance, read back from the change log
+    cursor.execute(
+        "SELECT user_id FROM realworld.follow(%s, 'jake')", (reader_id,))
+    await service_client.invalidate_caches(clean_update=False)
+    assert (await get_profile("jake", reader))["following"]
+
+    cursor.execute(
+        "SELECT user_id FROM realworld.unfollow(%s, 'jake')", (reader_id,))
+    await service_client.invalidate_caches(clean_update=False)
+    assert not (await get_profile("jake", reader))["following"]
+
+
+async def test_follow_user_not_cached_yet(
+        service_client, register, get_profile):
+    reader = await register("reader")
+    await service_client.invalidate_caches()
+    await register("jake")
+
+    await follow(service_client, reader, "jake")
+    await service_client.invalidate_caches(clean_update=False)
+    assert (await get_profile("jake", reader))["following"]
+
+    response = await service_client.post(
+        "/api/profiles/nobody/follow", headers=reader)
+    assert response.status == 404
@@ -0,0 +1,229 @@
+import json
+import pathlib
+import re
+import time
+
+import pytest
+
+
+# Loads a seeded dataset and runs every statement of src/db/sql.hpp with
+# auto_explain, failing on a sequential scan of a table that grows with the
+# service. A statement without a case below fails too, so new queries get
+# their plans checked.
+
+SQL_HPP = pathlib.Path(__file__).parent.parent.joinpath('src/db/sql.hpp')
+
+SEED = '''
+INSERT INTO realworld.users(username, email, password_hash)
+SELECT 'user' || i, 'user' || i || '@example.com', 'hash'
+FROM generate_series(1, 5000) AS i;
+
+INSERT INTO realworld.articles(title, slug, description, body, author_id,
+    created_at, updated_at)
+SELECT 'Article ' || i, 'article-' || i, 'description', 'body',
+    1 + (i * 7919) % 5000,
+    NOW() - make_interval(secs => 50000 - i),
+    NOW() - make_interval(secs => 50000 - i)
+FROM generate_series(1, 50000) AS i;
+
+INSERT INTO realworld.tags(name, updated_at)
+SELECT 'tag' || i, NOW() - make_interval(secs => 500 - i)
+FROM generate_series(1, 500) AS i;
+
+INSERT INTO realworld.article_tags(article_id, tag_id)
+SELECT DISTINCT a, 1 + (a * k * 31) % 500
+FROM generate_series(1, 50000) AS a CROSS JOIN generate_series(1, 3) AS k;
+
+UPDATE realworld.articles AS a
+SET tag_list = ARRAY(
+    SELECT t.name FROM realworld.article_tags AS at
+    INNER JOIN realworld.tags AS t ON t.tag_id = at.tag_id
+    WHERE at.article_id = a.article_id ORDER BY t.name);
+
+-- Bulk inserted tags bypass count_tag_articles, count them here
+UPDATE realworld.tags AS t
+SET articles_count = (
+    SELECT COUNT(*) FROM realworld.article_tags AS at
+    WHERE at.tag_id = t.tag_id);
+
+INSERT INTO realworld.favorites(user_id, article_id)
+SELECT DISTINCT 1 + (i::BIGINT * 104729) % 5000, 1 + (i * 7) % 50000
+FROM generate_series(1, 100000) AS i;
+
+INSERT INTO realworld.favorites_counters(article_id, shard, favorites_count)
+SELECT article_id, user_id % 16, COUNT(*)
+FROM realworld.favorites GROUP BY article_id, user_id % 16;
+
+INSERT INTO realworld.followers(follower, followed)
+SELECT DISTINCT u, 1 + (u * k * 13) % 5000
+FROM generate_series(1, 5000) AS u CROSS JOIN generate_series(1, 10) AS k
+WHERE u <> 1 + (u * k * 13) % 5000;
+
+INSERT INTO realworld.follow_changes(follower, followed, following,
+    changed_at)
+SELECT follower, followed, TRUE,
+    NOW() - make_interval(secs => (follower * 31 + followed) % 50000)
+FROM realworld.followers;
+
+INSERT INTO realworld.timelines(user_id, created_at, article_id, author_id)
+SELECT f.follower, a.created_at, a.article_id, a.author_id
+FROM realworld.followers AS f
+INNER JOIN realworld.articles AS a ON a.author_id = f.followed;
+
+INSERT INTO realworld.comments(author_id, article_id, body)
+SELECT 1 + (i * 31) % 5000, 1 + (i * 17) % 50000, 'comment'
+FROM generate_series(1, 50000) AS i;
+
+ANALYZE;
+'''
+
+LARGE_TABLES = {
+    'articles',
+    'article_tags',
+    'comments',
+    'favorites',
+    'favorites_counters',
+    'follow_changes',
+    'followers',
+    'timelines',
+    'users',
+}
+
+# The scans a statement is expected to do
+ALLOWED_SEQ_SCANS = {}
+
+# Cursor of article-40000, (created_at, article_id) in microseconds
+CURSOR = ('(EXTRACT(EPOCH FROM (SELECT created_at FROM realworld.articles '
+          'WHERE article_id = 40000)) * 1000000)::BIGINT')
+
+# Watermark of an incremental tags cache update, a few tags are newer
+UPDATED_AFTER = int((time.time() - 10) * 1000000)
+
+CASES = {
+    'kAddNewArticle': [
+        ('Title', 'new-article', 'description', 'body', 1,
+         ['tag1', 'new tag']),
+    ],
+    'kFollow': [(1, 'user4999'), (1, 'user14')],
+    'kUnfollow': [(1, 'user14')],
+    'kIsFavoritedArticle': [(7, 1)],
+    'kGetProfile': [(1, None), (1, 2)],
+    'kGetProfileByUsername': [('user1', None), ('user1', 2)],
+    'kGetArticleTagList': [(1,)],
+    'kUpdateArticleBySlug': [
+        ('article-1', 1 + 7919 % 5000, 'New title', 'new-slug', None, None,
+         None),
+        ('article-2', 1 + 2 * 7919 % 5000, None, None, None, None,
+         ['tag1', 'new tag']),
+    ],
+    'kDeleteArticleBySlug': [
+        ('article-1', 1 + 7919 % 5000), ('article-1', 1),
+    ],
+    'kGetArticleWithAuthorProfileBySlug': [
+        ('article-1', None), ('article-1', 2),
+    ],
+    'kGetArticleViewerFlags': [(1, 2)],
+    'kGetArticleIdBySlug': [('article-1',)],
+    'kGetArticleWithAuthorProfile': [(1, None), (1, 2)],
+    'kGetArticlesWithAuthorProfile': [
+        (None, None, None, None, 20, 0, None, None),
+        (None, None, None, 42, 20, 0, None, None),
+        ('tag7', None, None, 42, 20, 0, None, None),
+        (None, 'user42', None, 42, 20, 0, None, None),
+        (None, None, 'user42', 42, 20, 0, None, None),
+        (None, None, None, 42, 20, 0, CURSOR, 40000),
+    ],
+    'kGetFeed': [(42, 20, 0, None, None), (42, 20, 0, CURSOR, 40000)],
+    'kGetFollowerEdges': [(0, 0, 10000), (2500, 42, 10000)],
+    'kGetFollowChanges': [(UPDATED_AFTER,)],
+    'kGetFollowChangesWatermark': [()],
+    'kAddNewUser': [('new_user', 'new_user@example.com', 'hash')],
+    'kGetUserByEmail': [('user1@example.com',)],
+    'kGetUserByUsername': [('user1',)],
+    'kGetUserById': [(1,)],
+    'kUpdateUserById': [(1, 'renamed', None, None, 'bio', None)],
+    'kGetCommentsFromArticle': [
+        ('article-1', None, 0, None, None),
+        ('article-1', 20, 0, CURSOR, 1),
+    ],
+    'kAddNewComment': [('article-1', 'comment', 2)],
+    'kDeleteComment': [(1, 'article-18', 32), (1, 'article-18', 1)],
+    'kGetComment': [(1, None), (1, 2)],
+    'kFavoriteArticle': [('article-1', 2)],
+    'kUnfavoriteArticle': [('article-8', 1 + 104729 % 5000)],
+    'kGetTags': [(None,), (UPDATED_AFTER,)],
+}
+
+
+def read_statements():
+    statements = re.findall(
+        r'inline constexpr std::string_view (k\w+)\s*(?:=\s*|\{)'
+        r'R"~\((.*?)\)~"',
+        SQL_HPP.read_text(),
+        re.DOTALL,
+    )
+    return {name: sql.strip() for name, sql in statements}
+
+
+def to_psycopg(sql, params):
+    """$n placeholders to pyformat, CURSOR is pasted as an SQL expression"""
+    values = {}
+
+    def replace(match):
+        value = params[int(match.group(1)) - 1]
+        if value == CURSOR:
+            return '(' + CURSOR + ')'
+        values['p' + match.group(1)] = value
+        return '%(p' + match.group(1) + ')s'
+
+    return re.sub(r'\$(\d+)', replace, sql), values
+
+
+def seq_scans(plan):
+    if plan.get('Node Type') == 'Seq Scan':
+        yield plan['Relation Name']
+    for child in plan.get('Plans', []):
+        yield from seq_scans(child)
+
+
+def logged_plans(notices):
+    for notice in notices:
+        if 'plan:' in notice:
+            yield json.loads(notice[notice.index('{'):])['Plan']
+
+
+@pytest.fixture(name='seeded_db')
+def _seeded_db(pgsql):
+    cursor = pgsql['db_1'].cursor()
+    cursor.execute(SEED)
+    cursor.execute("LOAD 'auto_explain'")
+    cursor.execute('SET auto_explain.log_min_duration = 0')
+    cursor.execute('SET auto_explain.log_format = json')
+    cursor.execute('SET auto_explain.log_nested_statements = on')
+    cursor.execute('SET client_min_messages = log')
+    return pgsql['db_1']
+
+
+def test_every_statement_has_a_case():
+    assert set(read_statements()) == set(CASES)
+
+
+def test_no_seq_scans(seeded_db):
+    conn = seeded_db.conn
+    cursor = conn.cursor()
+    failures = []
+    for name, sql in sorted(read_statements().items()):
+        for params in CASES[name]:
+            query, values = to_psycopg(sql, params)
+            cursor.execute('BEGIN')
+            del conn.notices[:]
+            cursor.execute(query, values)
+            notices = list(conn.notices)
+            cursor.execute('ROLLBACK')
+            assert notices, f'{name}: auto_explain logged nothing'
+            for plan in logged_plans(notices):
+                for table in seq_scans(plan):
+                    if (table in LARGE_TABLES and
+                            table not in ALLOWED_SEQ_SCANS.get(name, ())):
+                        failures.append(f'{name}{params}: Seq Scan on {table}')
+    assert not failures, '\n'.join(failures)
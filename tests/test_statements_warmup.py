@@ -0,0 +1,17 @@
+import pathlib
+import re
+
+
+ROOT = pathlib.Path(__file__).parent.parent
+
+
+def test_every_statement_is_warmed_up():
+    statements = re.findall(
+        r'inline constexpr std::string_view (k\w+)',
+        ROOT.joinpath('src/db/sql.hpp').read_text(),
+    )
+    warmed_up = re.findall(
+        r'db::sql::(k\w+)\);',
+        ROOT.joinpath('src/components/statements_warmup.cpp').read_text(),
+    )
+    assert sorted(warmed_up) == sorted(statements)
@@ -0,0 +1,65 @@
+async def get_tags(service_client, params=None):
+    response = await service_client.get("/api/tags", params=params)
+    assert response.status == 200
+    return response.json()["tags"]
+
+
+def get_counter_mismatches(pgsql):
+    cursor = pgsql["db_1"].cursor()
+    cursor.execute("SELECT * FROM realworld.get_tag_counter_mismatches()")
+    return cursor.fetchall()
+
+
+async def test_tags_are_distinct(service_client, register, post_article):
+    author = await register("author")
+    await post_article(author, "First", ["zeta", "alpha"])
+    await post_article(author, "Second", ["alpha"])
+
+    await service_client.invalidate_caches()
+    assert await get_tags(service_client) == ["alpha", "zeta"]
+
+
+async def test_most_used_first(service_client, pgsql, register, post_article):
+    author = await register("author")
+    await post_article(author, "First", ["gamma"])
+    await post_article(author, "Second", ["beta", "gamma"])
+    await post_article(author, "Third", ["alpha", "gamma"])
+    await post_article(author, "Fourth", ["beta"])
+
+    await service_client.invalidate_caches()
+    assert await get_tags(service_client) == ["gamma", "beta", "alpha"]
+    assert await get_tags(service_client, {"limit": "2"}) == [
+        "gamma", "beta"]
+    assert await get_tags(service_client, {"limit": "100"}) == [
+        "gamma", "beta", "alpha"]
+    assert get_counter_mismatches(pgsql) == []
+
+    for limit in ["0", "101", "abc"]:
+        response = await service_client.get(
+            "/api/tags", params={"limit": limit})
+        assert response.status == 400
+
+
+async def test_incremental_update(
+        service_client, pgsql, register, post_article):
+    author = await register("author")
+    slug = await post_article(author, "First", ["alpha"])
+    await service_client.invalidate_caches()
+    assert await get_tags(service_client) == ["alpha"]
+
+    await post_article(author, "Second", ["beta"])
+    response = await service_client.put(
+        "/api/articles/" + slug,
+        json={"article": {"tagList": ["gamma"]}},
+        headers=author,
+    )
+    assert response.status == 200
+    await service_client.invalidate_caches(clean_update=False)
+    assert await get_tags(service_client) == ["beta", "gamma"]
+
+    response = await service_client.delete(
+        "/api/articles/" + slug, headers=author)
+    assert response.status == 200
+    await service_client.invalidate_caches(clean_update=False)
+    assert await get_tags(service_client) == ["beta"]
+    assert get_counter_mismatches(pgsql) == []
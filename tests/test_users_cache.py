@@ -0,0 +1,46 @@
+async def test_cached_users(service_client, register, get_profile):
+    jake = await register("jake")
+    reader = await register("reader")
+    await service_client.invalidate_caches()
+
+    response = await service_client.get("/api/user", headers=jake)
+    assert response.status == 200
+    assert response.json()["user"]["email"] == "jake@example.com"
+
+    profile = await get_profile("JAKE")
+    assert profile["username"] == "jake"
+    assert not profile["following"]
+    response = await service_client.post(
+        "/api/profiles/jake/follow", headers=reader)
+    assert response.status == 200
+    assert (await get_profile("jake", reader))["following"]
+
+    response = await service_client.get("/api/profiles/nobody")
+    assert response.status == 404
+
+
+async def test_update_is_read_back(service_client, register, get_profile):
+    jake = await register("jake")
+    await service_client.invalidate_caches()
+
+    response = await service_client.put(
+        "/api/user",
+        json={"user": {"username": "jacob", "bio": "I like to skateboard"}},
+        headers=jake,
+    )
+    assert response.status == 200
+
+    # Before the users cache rereads the user
+    response = await service_client.get("/api/user", headers=jake)
+    assert response.status == 200
+    assert response.json()["user"]["username"] == "jacob"
+    assert response.json()["user"]["bio"] == "I like to skateboard"
+    profile = await get_profile("Jacob")
+    assert profile["bio"] == "I like to skateboard"
+    response = await service_client.get("/api/profiles/jake")
+    assert response.status == 404
+
+    await service_client.invalidate_caches(clean_update=False)
+    assert (await get_profile("jacob"))["username"] == "jacob"
+    response = await service_client.get("/api/profiles/jake")
+    assert response.status == 404
@@ -0,0 +1,165 @@
+async def test_post_returns_article(service_client, register):
+    author = await register("author")
+    response = await service_client.post(
+        "/api/articles",
+        json={"article": {
+            "title": "Posted",
+            "description": "description",
+            "body": "body",
+            "tagList": ["writes"]
+        }
+        },
+        headers=author,
+    )
+    assert response.status == 200
+    article = response.json()["article"]
+    assert article["tagList"] == ["writes"]
+    assert article["author"]["username"] == "author"
+
+
+async def test_follow_is_idempotent(service_client, register):
+    await register("author")
+    reader = await register("reader")
+    url = "/api/profiles/author/follow"
+
+    for _ in range(2):
+        response = await service_client.post(url, headers=reader)
+        assert response.status == 200
+        assert response.json()["profile"]["following"]
+
+    for _ in range(2):
+        response = await service_client.delete(url, headers=reader)
+        assert response.status == 200
+        assert not response.json()["profile"]["following"]
+
+    response = await service_client.post(
+        "/api/profiles/nobody/follow", headers=reader)
+    assert response.status == 404
+
+
+async def test_favorite_is_idempotent(service_client, register, post_article):
+    author = await register("author")
+    reader = await register("reader")
+    slug = await post_article(author, "Favorite", ["writes"])
+    url = "/api/articles/" + slug + "/favorite"
+
+    for _ in range(2):
+        response = await service_client.post(url, headers=reader)
+        assert response.status == 200
+        article = response.json()["article"]
+        assert article["favorited"]
+        assert article["favoritesCount"] == 1
+
+    response = await service_client.delete(url, headers=reader)
+    assert response.status == 200
+    assert response.json()["article"]["favoritesCount"] == 0
+
+    response = await service_client.post(
+        "/api/articles/nothing/favorite", headers=reader)
+    assert response.status == 404
+
+
+async def test_update_returns_article(
+        service_client, register, post_article, get_article):
+    author = await register("author")
+    reader = await register("reader")
+    slug = await post_article(author, "Draft", ["writes"])
+
+    response = await service_client.put(
+        "/api/articles/" + slug,
+        json={"article": {"body": "final body"}},
+        headers=author,
+    )
+    assert response.status == 200
+    article = response.json()["article"]
+    assert article["body"] == "final body"
+    assert article["tagList"] == ["writes"]
+
+    response = await service_client.put(
+        "/api/articles/" + slug,
+        json={"article": {"body": "not mine"}},
+        headers=reader,
+    )
+    assert response.status == 403
+    assert (await get_article(slug))["body"] == "final body"
+
+    response = await service_client.put(
+        "/api/articles/nothing",
+        json={"article": {"body": "lost"}},
+        headers=author,
+    )
+    assert response.status == 404
+
+
+async def test_update_tags(service_client, register, post_article):
+    author = await register("author")
+    slug = await post_article(author, "Retagged", ["writes"])
+
+    response = await service_client.put(
+        "/api/articles/" + slug,
+        json={"article": {"tagList": ["zeta", "alpha", "zeta"]}},
+        headers=author,
+    )
+    assert response.status == 200
+    assert response.json()["article"]["tagList"] == ["alpha", "zeta"]
+
+    response = await service_client.get(
+        "/api/articles", params={"tag": "alpha"})
+    assert response.status == 200
+    assert [article["slug"] for article in response.json()["articles"]] == [
+        slug]
+    response = await service_client.get(
+        "/api/articles", params={"tag": "writes"})
+    assert response.status == 200
+    assert response.json()["articles"] == []
+
+
+async def test_delete_article_of_another_author(
+        service_client, register, post_article):
+    author = await register("author")
+    reader = await register("reader")
+    slug = await post_article(author, "Keep", ["writes"])
+
+    response = await service_client.delete(
+        "/api/articles/" + slug, headers=reader)
+    assert response.status == 403
+    response = await service_client.get("/api/articles/" + slug)
+    assert response.status == 200
+
+    response = await service_client.delete(
+        "/api/articles/" + slug, headers=author)
+    assert response.status == 200
+    response = await service_client.delete(
+        "/api/articles/" + slug, headers=author)
+    assert response.status == 404
+
+
+async def test_comments(service_client, register, post_article):
+    author = await register("author")
+    reader = await register("reader")
+    slug = await post_article(author, "Discussed", ["writes"])
+    url = "/api/articles/" + slug + "/comments"
+
+    response = await service_client.post(
+        url, json={"comment": {"body": "First"}}, headers=reader)
+    assert response.status == 200
+    comment = response.json()["comment"]
+    assert comment["body"] == "First"
+    assert comment["author"]["username"] == "reader"
+
+    response = await service_client.post(
+        "/api/articles/nothing/comments",
+        json={"comment": {"body": "Lost"}},
+        headers=reader,
+    )
+    assert response.status == 404
+    response = await service_client.get("/api/articles/nothing/comments")
+    assert response.status == 404
+
+    comment_url = url + "/" + str(comment["id"])
+    response = await service_client.delete(comment_url, headers=author)
+    assert response.status == 403
+    response = await service_client.delete(comment_url, headers=reader)
+    assert response.status == 200
+    response = await service_client.delete(comment_url, headers=reader)
+    assert response.status == 404